@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  BatchBenchmark.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+// Measures the throughput of a PetriNetBatch executing many instances of a loop net. The first
+// state of the net increments the variable of its instance, and hands the token over to a second
+// state which gives it back, until the variable reaches the count of iterations.
+//
+// Usage: BatchBenchmark [instances] [iterations per instance]
+
+#include "../Runtime/Cpp/Action.h"
+#include "../Runtime/Cpp/Atomic.h"
+#include "../Runtime/Cpp/PetriNet.h"
+#include "../Runtime/Cpp/PetriNetBatch.h"
+#include "../Runtime/Cpp/PetriNetTemplate.h"
+#include "../Runtime/Cpp/Transition.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+using namespace Petri;
+
+namespace {
+    std::unique_ptr<PetriNet> makeLoop(std::int64_t iterations) {
+        auto petriNet = std::make_unique<PetriNet>("Loop");
+        petriNet->addVariable(0);
+
+        auto &increment = petriNet->addAction(1,
+                                              "increment",
+                                              [](PetriNet &pn) {
+                                                  return static_cast<actionResult_t>(++pn.getVariable(0).value());
+                                              },
+                                              1,
+                                              true);
+        increment.addVariable(0);
+        auto &next = petriNet->addAction(2, "next", [](PetriNet &) { return actionResult_t{}; }, 1);
+        auto &end = petriNet->addAction(3, "end", [](PetriNet &) { return actionResult_t{}; }, 1);
+
+        increment.addTransition(4, "loop", next, [iterations](PetriNet &, actionResult_t result) {
+            return result < iterations;
+        });
+        increment.addTransition(5, "exit", end, [iterations](PetriNet &, actionResult_t result) {
+            return result >= iterations;
+        });
+        next.addTransition(6, "back", increment, [](PetriNet &, actionResult_t) { return true; });
+
+        return petriNet;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t instances = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::int64_t iterations = argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 100;
+    instances = std::max<std::size_t>(instances, 1);
+
+    PetriNetTemplate petriNetTemplate(makeLoop(iterations));
+    PetriNetBatch batch(petriNetTemplate, instances);
+
+    batch.run();
+    auto sweeps = batch.runUntilQuiescent();
+
+    // Every instance must have completed its own loop.
+    auto values = batch.values(0);
+    if(batch.activeInstances() != 0 || std::any_of(values, values + instances, [iterations](std::int64_t value) {
+           return value != iterations;
+       })) {
+        std::cerr << "The instances have not completed their loop!" << std::endl;
+        return 1;
+    }
+
+    auto const &statistics = batch.statistics();
+    std::cout << instances << " instances, " << iterations << " iterations per instance" << std::endl;
+    std::cout << "sweeps:      " << sweeps << std::endl;
+    std::cout << "actions:     " << statistics.actions << std::endl;
+    std::cout << "evaluations: " << statistics.evaluations << std::endl;
+    std::cout << "throughput:  " << statistics.actionsPerSecond() / 1e6 << " M actions/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  VariablesBenchmark.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+// Measures the throughput of threads each modifying its own variable, the way the actions of a
+// petri net do, depending on the layout of the variables in memory:
+//  - packed: the variables are contiguous, as they were before the VariableArena;
+//  - arena: each variable lies on its own cache lines.
+//
+// Usage: VariablesBenchmark [threads] [iterations per thread]
+
+#include "../Runtime/Cpp/detail/VariableArena.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace Petri;
+
+namespace {
+    // What the executor does around an action modifying a single variable.
+    void modify(Atomic &variable, std::size_t iterations) {
+        for(std::size_t i = 0; i < iterations; ++i) {
+            {
+                auto lock = variable.getLock();
+                lock.lock();
+                ++variable.value();
+            }
+            variable.notifyChange();
+        }
+    }
+
+    double run(std::vector<Atomic *> const &variables, std::size_t iterations) {
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for(auto variable : variables) {
+            threads.emplace_back([variable, iterations]() { modify(*variable, iterations); });
+        }
+        for(auto &thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        return variables.size() * iterations / duration.count();
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    std::size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    threads = std::max<std::size_t>(threads, 1);
+
+    std::deque<Atomic> packed;
+    VariableArena arena;
+    std::vector<Atomic *> packedVariables, arenaVariables;
+    for(std::size_t i = 0; i < threads; ++i) {
+        packed.emplace_back();
+        packedVariables.push_back(&packed.back());
+        arenaVariables.push_back(&arena.emplace());
+    }
+
+    std::cout << threads << " threads, " << iterations << " modifications per thread" << std::endl;
+    std::cout << "packed: " << run(packedVariables, iterations) / 1e6 << " M modifications/s" << std::endl;
+    std::cout << "arena:  " << run(arenaVariables, iterations) / 1e6 << " M modifications/s" << std::endl;
+
+    return 0;
+}
@@ -180,6 +180,13 @@ namespace Petri.Editor.Code
             return l1;
         }
 
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            var l1 = Code.Operator.IsAssignment(this.Operator) ? Expression1.GetVariables() : Expression1.GetWrittenVariables();
+            l1.AddRange(Expression2.GetWrittenVariables());
+            return l1;
+        }
+
     }
 }
 
@@ -77,6 +77,54 @@ namespace Petri.Editor.Code
             return result;
         }
 
+        /// <summary>
+        /// Returns the variables the expression may modify. Any variable whose use is not known to
+        /// be a read is considered as modified.
+        /// </summary>
+        /// <returns>The written variables.</returns>
+        public virtual List<VariableExpression> GetWrittenVariables()
+        {
+            return GetVariables();
+        }
+
+        /// <summary>
+        /// Returns whether the expression only uses a single variable with a single operation: it
+        /// either reads it once, assigns it, or increments or decrements it. Such an expression needs
+        /// no lock, as the operation can be performed atomically.
+        /// </summary>
+        /// <returns><c>true</c> if the expression can access its variable atomically.</returns>
+        public bool IsSingleVariableOperation()
+        {
+            if(GetVariables().Count != 1) {
+                return false;
+            }
+            if(GetWrittenVariables().Count == 0) {
+                return true;
+            }
+
+            var e = this;
+            while(e is WrapperFunctionInvocation) {
+                e = ((WrapperFunctionInvocation)e).Arguments[0];
+            }
+
+            if(e is UnaryExpression) {
+                var unary = (UnaryExpression)e;
+                switch(unary.Operator) {
+                case Code.Operator.Name.PreIncr:
+                case Code.Operator.Name.PreDecr:
+                case Code.Operator.Name.PostIncr:
+                case Code.Operator.Name.PostDecr:
+                    return unary.Expression is VariableExpression;
+                }
+            }
+            else if(e is BinaryExpression) {
+                var binary = (BinaryExpression)e;
+                return binary.Operator == Code.Operator.Name.Assignment && binary.Expression1 is VariableExpression;
+            }
+
+            return false;
+        }
+
         public virtual bool NeedsReturn { get { return false; } }
 
         public static Expression CreateFromStringAndEntity(string s,
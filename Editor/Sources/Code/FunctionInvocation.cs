@@ -130,6 +130,23 @@ namespace Petri.Editor.Code
 
             return l1;
         }
+
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            var l = new List<VariableExpression>();
+            for(int i = 0; i < Arguments.Count; ++i) {
+                // A variable bound to a reference parameter may be modified by the function
+                var type = Function.Parameters[i].Type;
+                if(type.IsReference || type.Equals(Type.UnknownType(Language))) {
+                    l.AddRange(Arguments[i].GetVariables());
+                }
+                else {
+                    l.AddRange(Arguments[i].GetWrittenVariables());
+                }
+            }
+
+            return l;
+        }
     }
 
     public class MethodInvocation : FunctionInvocation
@@ -175,6 +192,14 @@ namespace Petri.Editor.Code
 
             return l1;
         }
+
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            var l1 = base.GetWrittenVariables();
+            l1.AddRange(This.GetVariables());
+
+            return l1;
+        }
     }
 
     public class ConflictFunctionInvocation : FunctionInvocation
@@ -261,6 +286,11 @@ namespace Petri.Editor.Code
         {
             return Arguments[0].MakeUserReadable();
         }
+
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            return Arguments[0].GetWrittenVariables();
+        }
     }
 }
 
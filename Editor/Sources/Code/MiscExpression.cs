@@ -57,6 +57,11 @@ namespace Petri.Editor.Code
             return new List<LiteralExpression>();
         }
 
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            return new List<VariableExpression>();
+        }
+
         public bool DoWeCare { get; private set; }
 
     }
@@ -100,6 +105,14 @@ namespace Petri.Editor.Code
             return l;
         }
 
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            var l = Before.GetWrittenVariables();
+            l.AddRange(Expression.GetWrittenVariables());
+            l.AddRange(After.GetWrittenVariables());
+            return l;
+        }
+
     }
 
     public class LiteralExpression : Expression
@@ -179,6 +192,11 @@ namespace Petri.Editor.Code
             return l;
         }
 
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            return new List<VariableExpression>();
+        }
+
     }
 
     public class VariableExpression : LiteralExpression
@@ -199,7 +217,16 @@ namespace Petri.Editor.Code
                 return "(*PetriNet_getVariable(petriNet, (uint_fast32_t)(" + Prefix + Expression + ")))";
             }
             else if(Language == Language.Cpp) {
-                return "petriNet.getVariable(static_cast<std::uint_fast32_t>(" + Prefix + Expression + ")).value()";
+                var variable = "petriNet.getVariable(static_cast<std::uint_fast32_t>(" + Prefix + Expression + "))";
+                switch(LockFree) {
+                case LockFreeAccess.Read:
+                    // The value is read once, and not given as a proxy to a function or a template.
+                    return "static_cast<std::int64_t>(" + variable + ".lockFreeValue())";
+                case LockFreeAccess.Write:
+                    return variable + ".lockFreeValue()";
+                default:
+                    return variable + ".value()";
+                }
             }
             else if(Language == Language.CSharp) {
                 return "petriNet.GetVariable((UInt32)(" + Prefix + Expression + ")).Value";
@@ -239,6 +266,26 @@ namespace Petri.Editor.Code
 
         public static string EnumName { get { return "Petri_Var_Enum"; } }
 
+        /// <summary>
+        /// How a variable is accessed without lock, with a single atomic operation.
+        /// </summary>
+        public enum LockFreeAccess
+        {
+            // The variable is locked.
+            None,
+            // The variable is read once.
+            Read,
+            // The variable is assigned, incremented or decremented once.
+            Write
+        }
+
+        /// <summary>
+        /// Gets or sets whether the variable is accessed without lock, with a single atomic operation.
+        /// Only the C++ code honors it.
+        /// </summary>
+        /// <value>The way the variable is accessed atomically, if any.</value>
+        public LockFreeAccess LockFree { get; set; }
+
     }
 
     // Could have been TernaryExpression, but there is only one ternary operator in C++, so we already specialize it.
@@ -289,6 +336,14 @@ namespace Petri.Editor.Code
             return l1;
         }
 
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            var l1 = Expression1.GetWrittenVariables();
+            l1.AddRange(Expression2.GetWrittenVariables());
+            l1.AddRange(Expression3.GetWrittenVariables());
+            return l1;
+        }
+
     }
 
     public class ExpressionList : Expression
@@ -333,6 +388,15 @@ namespace Petri.Editor.Code
             return l;
         }
 
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            var l = new List<VariableExpression>();
+            foreach(var e in Expressions) {
+                l.AddRange(e.GetWrittenVariables());
+            }
+            return l;
+        }
+
     }
 }
 
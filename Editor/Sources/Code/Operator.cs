@@ -200,6 +200,31 @@ namespace Petri.Editor.Code
             private set;
         }
 
+        /// <summary>
+        /// Returns whether the operator modifies its left operand, such as = or +=.
+        /// </summary>
+        /// <returns><c>true</c> if the operator is an assignment.</returns>
+        /// <param name="op">The operator.</param>
+        public static bool IsAssignment(Name op)
+        {
+            switch(op) {
+            case Name.Assignment:
+            case Name.PlusAssign:
+            case Name.MinusAssign:
+            case Name.MultAssign:
+            case Name.DivAssign:
+            case Name.ModAssign:
+            case Name.ShiftLeftAssign:
+            case Name.ShiftRightAssign:
+            case Name.BitwiseAndAssig:
+            case Name.BitwiseXorAssign:
+            case Name.BitwiseOrAssign:
+                return true;
+            default:
+                return false;
+            }
+        }
+
         static Operator()
         {
             Properties = new Dictionary<Name, Op>();
@@ -112,6 +112,21 @@ namespace Petri.Editor.Code
         {
             return Expression.GetLiterals();
         }
+
+        public override List<VariableExpression> GetWrittenVariables()
+        {
+            switch(this.Operator) {
+            case Code.Operator.Name.PreIncr:
+            case Code.Operator.Name.PreDecr:
+            case Code.Operator.Name.PostIncr:
+            case Code.Operator.Name.PostDecr:
+            // The address of a variable can be used to modify it
+            case Code.Operator.Name.AddressOf:
+                return Expression.GetVariables();
+            }
+
+            return Expression.GetWrittenVariables();
+        }
     }
 }
 
@@ -239,6 +239,8 @@ namespace Petri.Editor.CodeGen
 
             var cppVar = new HashSet<VariableExpression>();
             a.GetVariables(cppVar);
+            var cppWrittenVar = new HashSet<VariableExpression>();
+            a.GetWrittenVariables(cppWrittenVar);
 
             _functionPrototypes += "static Petri_actionResult_t " + a.CodeIdentifier + "_invocation(struct PetriNet *);";
 
@@ -271,7 +273,8 @@ namespace Petri.Editor.CodeGen
             + a.Parent.Name + "_" + a.Name + "\", &" + a.CodeIdentifier + "_invocation, " + a.RequiredTokens.ToString() + ");";
             CodeGen += "PetriNet_addAction(petriNet, " + a.CodeIdentifier + ", " + ((a.Active && (a.Parent is RootPetriNet)) ? "true" : "false") + ");";
             foreach(var v in cppVar) {
-                CodeGen += "PetriAction_addVariable(" + a.CodeIdentifier + ", (uint32_t)(" + v.Prefix + v.Expression + "));";
+                var function = cppWrittenVar.Contains(v) ? "PetriAction_addVariable(" : "PetriAction_addReadVariable(";
+                CodeGen += function + a.CodeIdentifier + ", (uint32_t)(" + v.Prefix + v.Expression + "));";
             }
                       foreach(var tup in old) {
                 tup.Key.Expression = tup.Value;
@@ -348,6 +351,8 @@ namespace Petri.Editor.CodeGen
 
             var cppVar = new HashSet<VariableExpression>();
             t.GetVariables(cppVar);
+            var cppWrittenVar = new HashSet<VariableExpression>();
+            t.GetWrittenVariables(cppWrittenVar);
 
             _functionPrototypes += "static bool " + t.CodeIdentifier + "_invocation(struct PetriNet *, Petri_actionResult_t);";
 
@@ -379,7 +384,8 @@ namespace Petri.Editor.CodeGen
             CodeGen += decl + "PetriAction_addTransitionWithParam(" + bName + ", " + t.ID.ToString() + ", \"" + t.Name + "\", " + aName + ", "
             + "&" + t.CodeIdentifier + "_invocation" + ");";
             foreach(var v in cppVar) {
-                CodeGen += "PetriTransition_addVariable(" + t.CodeIdentifier + ", (uint32_t)(" + v.Prefix + v.Expression + "));";
+                var function = cppWrittenVar.Contains(v) ? "PetriTransition_addVariable(" : "PetriTransition_addReadVariable(";
+                CodeGen += function + t.CodeIdentifier + ", (uint32_t)(" + v.Prefix + v.Expression + "));";
             }
 
             foreach(var tup in old) {
@@ -46,6 +46,15 @@ namespace Petri.Editor.CodeGen
                 System.IO.File.WriteAllText(PathToFile(Document.Settings.Name + ".h"),
                                             _headerGen.Value);
             }
+
+            if(Document.Settings.StripNames) {
+                var table = new System.Text.StringBuilder();
+                foreach(var entry in _strippedNames) {
+                    table.Append(entry.Item1).Append('\t').Append(entry.Item2).Append('\n');
+                }
+                System.IO.File.WriteAllText(PathToFile(Document.Settings.Name + ".names"),
+                                            table.ToString());
+            }
         }
 
         public override void WriteExpressionEvaluator(Expression expression, string path, params object[] userData)
@@ -119,6 +128,8 @@ namespace Petri.Editor.CodeGen
 
             CodeGen += "namespace {";
             _prototypesIndex = CodeGen.Value.Length;
+            _names = new Dictionary<string, int>();
+            _strippedNames = new List<Tuple<UInt64, string>>();
             CodeGen += "void fill(PetriNet &petriNet) {";
 
             foreach(var e in Document.PetriNet.Variables) {
@@ -128,7 +139,7 @@ namespace Petri.Editor.CodeGen
 
         protected override void End()
         {
-            CodeGen.Value = CodeGen.Value.Substring(0, _prototypesIndex) + _functionPrototypes.Value + "\n" + CodeGen.Value.Substring(_prototypesIndex);
+            CodeGen.Value = CodeGen.Value.Substring(0, _prototypesIndex) + GenerateNameTable() + _functionPrototypes.Value + "\n" + CodeGen.Value.Substring(_prototypesIndex);
 
             CodeGen += "}"; // fill()
 
@@ -255,10 +266,15 @@ namespace Petri.Editor.CodeGen
                 }
             }
 
+            // A single operation on a single variable is performed atomically, without lock
+            bool lockFree = MarkLockFreeVariables(a.Function);
+
             var cpp = "static_cast<actionResult_t>(" + a.Function.MakeCode() + ")";
 
             var cppVar = new HashSet<VariableExpression>();
             a.GetVariables(cppVar);
+            var cppWrittenVar = new HashSet<VariableExpression>();
+            a.GetWrittenVariables(cppWrittenVar);
 
             _functionPrototypes += "Petri_actionResult_t " + a.CodeIdentifier + "_invocation(PetriNet &);";
 
@@ -272,22 +288,62 @@ namespace Petri.Editor.CodeGen
             string action = "&" + a.CodeIdentifier + "_invocation";
 
             CodeGen += "auto &" + a.CodeIdentifier + " = " + "petriNet.addAction("
-            + "Action(" + a.ID.ToString() + ", \"" + a.Parent.Name + "_" + a.Name + "\", " + action + ", " + a.RequiredTokens.ToString() + "), " + ((a.Active && (a.Parent is RootPetriNet)) ? "true" : "false") + ");";
+            + a.ID.ToString() + ", " + InternName(a.ID, a.Parent.Name + "_" + a.Name) + ", " + action + ", " + a.RequiredTokens.ToString() + ", " + ((a.Active && (a.Parent is RootPetriNet)) ? "true" : "false") + ");";
 
             foreach(var v in cppVar) {
-                CodeGen += a.CodeIdentifier + ".addVariable(" + "static_cast<std::uint_fast32_t>(" + v.Prefix + v.Expression + "));";
+                var access = GetVariableAccess(cppWrittenVar.Contains(v), lockFree);
+                CodeGen += a.CodeIdentifier + ".addVariable(" + "static_cast<std::uint_fast32_t>(" + v.Prefix + v.Expression + ")" + access + ");";
             }
 
             foreach(var tup in old) {
                 tup.Key.Expression = tup.Value;
             }
+            foreach(var v in a.Function.GetVariables()) {
+                v.LockFree = VariableExpression.LockFreeAccess.None;
+            }
+        }
+
+        /// <summary>
+        /// Marks the variable of an expression performing a single operation on a single variable as
+        /// accessed atomically, without lock.
+        /// </summary>
+        /// <returns><c>true</c> if the expression accesses its variable atomically.</returns>
+        /// <param name="expression">The function of an action or the condition of a transition.</param>
+        static bool MarkLockFreeVariables(Expression expression)
+        {
+            if(!expression.IsSingleVariableOperation()) {
+                return false;
+            }
+
+            var access = expression.GetWrittenVariables().Count == 0 ? VariableExpression.LockFreeAccess.Read
+                                                                     : VariableExpression.LockFreeAccess.Write;
+            foreach(var v in expression.GetVariables()) {
+                v.LockFree = access;
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Returns the VariableAccess argument given to addVariable() for a variable of an entity.
+        /// </summary>
+        /// <returns>The argument, including its leading comma, or an empty string for the default access.</returns>
+        /// <param name="written">Whether the entity may modify the variable.</param>
+        /// <param name="lockFree">Whether the entity accesses the variable with a single atomic operation.</param>
+        static string GetVariableAccess(bool written, bool lockFree)
+        {
+            if(lockFree) {
+                return written ? ", VariableAccess::AtomicReadWrite" : ", VariableAccess::AtomicRead";
+            }
+
+            return written ? "" : ", VariableAccess::Read";
         }
 
         protected override void GenerateExitPoint(ExitPoint e, IDManager lastID)
         {
             CodeGen += "auto &" + e.CodeIdentifier + " = petriNet.addAction(" +
-            "Action(" + e.ID.ToString() + ", \"" + e.Parent.Name + "_" + e.Name + "\", make_action_callable([](){ return actionResult_t(); }), " + e.RequiredTokens.ToString()
-            + "), false);";
+            e.ID.ToString() + ", " + InternName(e.ID, e.Parent.Name + "_" + e.Name) + ", [](PetriNet &) { return actionResult_t(); }, " + e.RequiredTokens.ToString()
+            + ", false);";
         }
 
         protected override void GenerateInnerPetriNet(InnerPetriNet i, IDManager lastID)
@@ -296,7 +352,7 @@ namespace Petri.Editor.CodeGen
 
             // Adding an entry point
             CodeGen += "auto &" + name + " = petriNet.addAction("
-            + "Action(" + i.EntryPointID + ", \"" + i.Name + "_Entry\", make_action_callable([](){ return actionResult_t(); }), " + i.RequiredTokens.ToString() + "), " + (i.Active ? "true" : "false") + ");";
+            + i.EntryPointID + ", " + InternName(i.EntryPointID, i.Name + "_Entry") + ", [](PetriNet &) { return actionResult_t(); }, " + i.RequiredTokens.ToString() + ", " + (i.Active ? "true" : "false") + ");";
 
             // Adding a transition from the entry point to all of the initially active states
             foreach(State s in i.States) {
@@ -304,7 +360,7 @@ namespace Petri.Editor.CodeGen
                     var newID = lastID.Consume();
                     string tName = name + "_" + newID.ToString();
 
-                    CodeGen += name + ".addTransition(" + newID.ToString() + ", \"" + tName + "\", " + s.CodeIdentifier + ", make_transition_callable([](actionResult_t){ return true; }));";
+                    CodeGen += name + ".addTransition(" + newID.ToString() + ", " + InternName(newID, tName) + ", " + s.CodeIdentifier + ", [](PetriNet &, actionResult_t) { return true; });";
                 }
             }
         }
@@ -350,10 +406,14 @@ namespace Petri.Editor.CodeGen
                 aName = a.EntryPointName;
             }
 
+            bool lockFree = MarkLockFreeVariables(t.Condition);
+
             string cpp = "return " + t.Condition.MakeCode() + ";";
 
             var cppVar = new HashSet<VariableExpression>();
             t.GetVariables(cppVar);
+            var cppWrittenVar = new HashSet<VariableExpression>();
+            t.GetWrittenVariables(cppWrittenVar);
 
             _functionPrototypes += "bool " + t.CodeIdentifier + "_invocation(PetriNet &, Petri_actionResult_t);";
 
@@ -366,14 +426,58 @@ namespace Petri.Editor.CodeGen
 
             cpp = "&" + t.CodeIdentifier + "_invocation";
 
-            CodeGen += "auto &" + t.CodeIdentifier + " = " + bName + ".addTransition(" + t.ID.ToString() + ", \"" + t.Name + "\", " + aName + ", " + cpp + ");";
+            CodeGen += "auto &" + t.CodeIdentifier + " = " + bName + ".addTransition(" + t.ID.ToString() + ", " + InternName(t.ID, t.Name) + ", " + aName + ", " + cpp + ");";
             foreach(var v in cppVar) {
-                CodeGen += t.CodeIdentifier + ".addVariable(" + "static_cast<std::uint_fast32_t>(" + v.Prefix + v.Expression + "));";
+                var access = GetVariableAccess(cppWrittenVar.Contains(v), lockFree);
+                CodeGen += t.CodeIdentifier + ".addVariable(" + "static_cast<std::uint_fast32_t>(" + v.Prefix + v.Expression + ")" + access + ");";
             }
 
             foreach(var tup in old) {
                 tup.Key.Expression = tup.Value;
             }
+            foreach(var v in t.Condition.GetVariables()) {
+                v.LockFree = VariableExpression.LockFreeAccess.None;
+            }
+        }
+
+        /// <summary>
+        /// Adds the name of an entity to the name table of the generated code, unless the names are stripped.
+        /// The entities sharing a name share the same entry.
+        /// </summary>
+        /// <returns>The InternedName argument referring to the entry of the table.</returns>
+        /// <param name="id">The ID of the entity.</param>
+        /// <param name="name">The name of the entity.</param>
+        string InternName(UInt64 id, string name)
+        {
+            if(Document.Settings.StripNames) {
+                _strippedNames.Add(Tuple.Create(id, name));
+                return "InternedName()";
+            }
+
+            int index;
+            if(!_names.TryGetValue(name, out index)) {
+                index = _names.Count;
+                _names.Add(name, index);
+            }
+
+            return "InternedName(_names[" + index.ToString() + "])";
+        }
+
+        /// <summary>
+        /// Generates the table of the names of the entities, which they refer to instead of copying them.
+        /// </summary>
+        /// <returns>The definition of the table, or an empty string if there is no name.</returns>
+        string GenerateNameTable()
+        {
+            if(_names.Count == 0) {
+                return "";
+            }
+
+            var names = from n in _names
+                                 orderby n.Value
+                                 select "\"" + n.Key + "\"";
+
+            return "std::string const _names[] = {" + String.Join(", ", names) + "};\n";
         }
 
         protected string GenerateVarEnum()
@@ -394,6 +498,8 @@ namespace Petri.Editor.CodeGen
         private CodeGen _headerGen;
         private bool _generateHeader = true;
         private int _prototypesIndex;
+        private Dictionary<string, int> _names;
+        private List<Tuple<UInt64, string>> _strippedNames;
     }
 }
 
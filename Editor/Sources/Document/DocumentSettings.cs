@@ -65,6 +65,7 @@ namespace Petri.Editor
             elem.SetAttributeValue("Port", Port.ToString());
             elem.SetAttributeValue("Language", Language.ToString());
             elem.SetAttributeValue("RunInEditor", RunInEditor.ToString());
+            elem.SetAttributeValue("StripNames", StripNames.ToString());
 
             var node = new XElement("Compiler");
             node.SetAttributeValue("Invocation", Compiler);
@@ -133,6 +134,7 @@ namespace Petri.Editor
             this.Port = 12345;
             this.Language = Code.Language.Cpp;
             this.RunInEditor = false;
+            this.StripNames = false;
 
             Name = "MyPetriNet";
             Enum = DefaultEnum;
@@ -175,6 +177,10 @@ namespace Petri.Editor
                     RunInEditor = bool.Parse(elem.Attribute("RunInEditor").Value);
                 }
 
+                if(elem.Attribute("StripNames") != null) {
+                    StripNames = bool.Parse(elem.Attribute("StripNames").Value);
+                }
+
                 var node = elem.Element("Compiler");
                 if(node != null) {
                     Compiler = node.Attribute("Invocation").Value;
@@ -344,6 +350,16 @@ namespace Petri.Editor
             set;
         }
 
+        /// <summary>
+        /// Gets or sets a value indicating whether the names of the states and transitions are left out of the generated C++ code.
+        /// The entities of the petri net are then only known by their IDs, and a side table mapping the IDs to the names is generated next to the source.
+        /// </summary>
+        /// <value><c>true</c> if the names are stripped; otherwise, <c>false</c>.</value>
+        public bool StripNames {
+            get;
+            set;
+        }
+
         /// <summary>
         /// A readable name for the provided language.
         /// </summary>
@@ -88,6 +88,16 @@ namespace Petri.Editor.GUI
                     newSettings.RunInEditor = _runInEditor.Active;
                     _document.CommitGuiAction(new ChangeSettingsAction(_document, newSettings));
                 };
+                _stripNames = new CheckButton(Configuration.GetLocalized("Strip the names of the entities from the generated code"));
+                _stripNames.Toggled += (sender, e) => {
+                    if(_updating) {
+                        return;
+                    }
+
+                    var newSettings = _document.Settings.Clone();
+                    newSettings.StripNames = _stripNames.Active;
+                    _document.CommitGuiAction(new ChangeSettingsAction(_document, newSettings));
+                };
 
                 _labelName = new Label(Configuration.GetLocalized("<language> name of the Petri net:",
                                                                   _document.Settings.LanguageName()));
@@ -123,6 +133,7 @@ namespace Petri.Editor.GUI
 
                 vbox.PackStart(_languageCombo, false, false, 0);
                 vbox.PackStart(_runInEditor, false, false, 0);
+                vbox.PackStart(_stripNames, false, false, 0);
                 var hbox = new HBox(false, 5);
                 hbox.PackStart(_labelName, false, false, 0);
                 vbox.PackStart(hbox, false, false, 0);
@@ -528,6 +539,7 @@ namespace Petri.Editor.GUI
             } while(_languageCombo.Model.IterNext(ref iter));
 
             _runInEditor.Active = _document.Settings.RunInEditor;
+            _stripNames.Active = _document.Settings.StripNames;
 
             _nameEntry.Text = _document.Settings.Name;
 
@@ -581,6 +593,9 @@ namespace Petri.Editor.GUI
             if(_document.Settings.Language == Code.Language.CSharp) {
                 _headersSearchPathBox.Hide();
             }
+            if(_document.Settings.Language != Code.Language.Cpp) {
+                _stripNames.Hide();
+            }
 
             _document.Window.EditorGui.UpdateGUIForLanguage();
         }
@@ -755,6 +770,7 @@ namespace Petri.Editor.GUI
         Document _document;
 
         CheckButton _runInEditor;
+        CheckButton _stripNames;
 
         RadioButton _defaultEnum, _customEnum;
         Entry _customEnumEditor;
@@ -132,6 +132,18 @@ namespace Petri.Editor
                 res.Add(ll);
             }
         }
+
+        /// <summary>
+        /// Adds the VariableExpressions the action may modify to the set passed as an argument.
+        /// </summary>
+        /// <param name="res">Result.</param>
+        public void GetWrittenVariables(HashSet<VariableExpression> res)
+        {
+            var l = Function.GetWrittenVariables();
+            foreach(var ll in l) {
+                res.Add(ll);
+            }
+        }
     }
 }
 
@@ -264,6 +264,18 @@ namespace Petri.Editor
                 result.Add(ll);
             }
         }
+
+        /// <summary>
+        /// Adds the VariableExpressions the condition may modify to the set passed as an argument.
+        /// </summary>
+        /// <param name="result">Result.</param>
+        public void GetWrittenVariables(HashSet<VariableExpression> result)
+        {
+            var l = Condition.GetWrittenVariables();
+            foreach(var ll in l) {
+                result.Add(ll);
+            }
+        }
     }
 }
 
@@ -237,6 +237,72 @@ namespace Petri.Test.Code
             Assert.AreEqual(((LiteralExpression)bin.Expression1).Expression, "3");
             Assert.AreEqual(((LiteralExpression)bin.Expression2).Expression, "4");
         }
+
+        [Test()]
+        public void TestReadVariables()
+        {
+            // GIVEN a comparison of two variables
+            var comparison = "$a == $b + 1";
+
+            // WHEN we create an expression from it
+            var e = Expression.CreateFromString(comparison, Language.Cpp);
+
+            // THEN both variables are used, but none of them is written
+            Assert.AreEqual(2, e.GetVariables().Count);
+            Assert.AreEqual(0, e.GetWrittenVariables().Count);
+        }
+
+        [Test()]
+        public void TestWrittenVariables()
+        {
+            // GIVEN an assignment and an increment of variables
+            var assignment = "$a = $b + 1; ++$c";
+
+            // WHEN we create an expression from it
+            var e = Expression.CreateFromString(assignment, Language.Cpp);
+
+            // THEN only the assigned and incremented variables are written
+            var written = e.GetWrittenVariables();
+            Assert.AreEqual(2, written.Count);
+            Assert.Contains(new VariableExpression("a", Language.Cpp), written);
+            Assert.Contains(new VariableExpression("c", Language.Cpp), written);
+        }
+
+        [Test()]
+        public void TestSingleVariableOperations()
+        {
+            // GIVEN expressions performing a single operation on a single variable
+            // THEN they can access the variable atomically
+            Assert.IsTrue(Expression.CreateFromString("++$i", Language.Cpp).IsSingleVariableOperation());
+            Assert.IsTrue(Expression.CreateFromString("$x = 3", Language.Cpp).IsSingleVariableOperation());
+            Assert.IsTrue(Expression.CreateFromString("$mode == 2", Language.Cpp).IsSingleVariableOperation());
+
+            // GIVEN expressions using a variable twice or several variables
+            // THEN they cannot
+            Assert.IsFalse(Expression.CreateFromString("$x = $x + 1", Language.Cpp).IsSingleVariableOperation());
+            Assert.IsFalse(Expression.CreateFromString("$a == $b", Language.Cpp).IsSingleVariableOperation());
+            Assert.IsFalse(Expression.CreateFromString("&$y", Language.Cpp).IsSingleVariableOperation());
+        }
+
+        [Test()]
+        public void TestLockFreeVariableCode()
+        {
+            // GIVEN a variable read atomically
+            var read = new VariableExpression("a", Language.Cpp);
+            read.LockFree = VariableExpression.LockFreeAccess.Read;
+
+            // THEN its value is read once, instead of being given as a proxy to the enclosing expression
+            StringAssert.StartsWith("static_cast<std::int64_t>(petriNet.getVariable(", read.MakeCode());
+            StringAssert.EndsWith(".lockFreeValue())", read.MakeCode());
+
+            // GIVEN a variable modified atomically
+            var written = new VariableExpression("a", Language.Cpp);
+            written.LockFree = VariableExpression.LockFreeAccess.Write;
+
+            // THEN it is modified through its proxy
+            StringAssert.StartsWith("petriNet.getVariable(", written.MakeCode());
+            StringAssert.EndsWith(".lockFreeValue()", written.MakeCode());
+        }
     }
 }
 
@@ -99,6 +99,7 @@ namespace Petri.Test.Editor.EditorController
             settings.Name = CodeUtility.RandomIdentifier();
 
             settings.RunInEditor = random.Next(2) != 0;
+            settings.StripNames = random.Next(2) != 0;
 
             settings.RelativeSourceOutputPath = TestUtility.RandomPath();
             settings.RelativeLibOutputPath = TestUtility.RandomPath();
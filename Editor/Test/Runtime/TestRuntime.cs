@@ -110,6 +110,934 @@ namespace Petri.Test
             Assert.IsEmpty(stderr);
         }
 
+        [Test()]
+        public void TestRuntimeCompletion()
+        {
+            // GIVEN a running petri net which completes its execution after a few states
+            PetriNet pn = new PetriNet("Test");
+
+            Action a1 = new Action(1, "action1", Action1, 1);
+            Action a2 = new Action(2, "action2", Action2, 1);
+            a1.AddTransition(3, "transition1", a2, Transition2);
+
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            int completions = 0;
+            pn.OnCompletion((System.IntPtr handle) => {
+                ++completions;
+            });
+
+            // WHEN we wait for its completion
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the net completed its execution and the completion callback has been invoked once
+            Assert.IsTrue(completed);
+            Assert.IsFalse(pn.IsRunning);
+            Assert.AreEqual(1, completions);
+            Assert.IsTrue(pn.JoinFor(System.TimeSpan.Zero));
+        }
+
+        public static System.Int32 CountedAction()
+        {
+            System.Threading.Interlocked.Increment(ref executedActions);
+            return 0;
+        }
+
+        [Test(), Repeat(200)]
+        public void TestRuntimeInitialStates()
+        {
+            // GIVEN a petri net with several initial states, which terminate as soon as they are executed
+            PetriNet pn = new PetriNet("Test");
+            for(UInt64 id = 0; id < 16; ++id) {
+                pn.AddAction(new Action(id, "action" + id, CountedAction, 1), true);
+            }
+
+            executedActions = 0;
+
+            // WHEN the net is run until its completion
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the net did not complete before all of its initial states were executed
+            Assert.IsTrue(completed);
+            Assert.AreEqual(16, executedActions);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeVariableChangeBeforeFirstEvaluation()
+        {
+            bool completed = true;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                for(int i = 0; i < 100 && completed; ++i) {
+                    // GIVEN a net in the VariableChange evaluation mode, whose second state waits for a variable to be set.
+                    // The transition depends on many other variables, which makes it subscribe to them for longer.
+                    PetriNet pn = new PetriNet("Test");
+                    pn.EvaluationMode = EvaluationMode.VariableChange;
+
+                    Action a1 = new Action(1, "action1", Utility.DoNothing, 1);
+                    Action a2 = new Action(2, "action2", Utility.DoNothing, 1);
+                    var variable = pn.GetVariable(0);
+                    Transition t = a1.AddTransition(3, "transition1", a2, (System.Int32 result) => variable.Value == 1);
+                    for(System.UInt32 id = 0; id < 64; ++id) {
+                        pn.AddVariable(id);
+                        t.AddReadVariable(id);
+                    }
+
+                    pn.AddAction(a1, true);
+                    pn.AddAction(a2, false);
+
+                    // WHEN the variable keeps being notified of changes while the first state starts waiting for it
+                    bool notifying = true;
+                    var notifier = new System.Threading.Thread(() => {
+                        while(notifying) {
+                            variable.Value = 0;
+                        }
+                    });
+                    notifier.Start();
+                    pn.Run();
+                    System.Threading.Thread.Sleep(1);
+                    notifying = false;
+                    notifier.Join();
+
+                    // THEN the waiting state has not been lost, and the net completes once its variable is set
+                    variable.Value = 1;
+                    completed = pn.JoinFor(System.TimeSpan.FromSeconds(5));
+                }
+            }, out stdout, out stderr);
+
+            Assert.IsTrue(completed);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeStopFromAction()
+        {
+            bool stopped = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                // GIVEN a running net, whose action stops it once the user has started doing so
+                PetriNet pn = new PetriNet("Test");
+                bool stopping = false;
+                Action a = new Action(1, "action", () => {
+                    while(!stopping) {
+                        System.Threading.Thread.Sleep(1);
+                    }
+                    System.Threading.Thread.Sleep(50);
+                    pn.Stop();
+                    return 0;
+                }, 1);
+                pn.AddAction(a, true);
+                pn.Run();
+
+                // WHEN the user stops the net while its action is running
+                var stopper = new System.Threading.Thread(() => pn.Stop());
+                stopper.IsBackground = true;
+                stopping = true;
+                stopper.Start();
+
+                // THEN both of them return
+                stopped = stopper.Join(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            Assert.IsTrue(stopped);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimePause()
+        {
+            // GIVEN a net whose actions pause for a given delay
+            PetriNet pn = new PetriNet("Test");
+            Action a1 = new Action(1, "action1", () => Utility.Pause(0.05), 1);
+            Action a2 = new Action(2, "action2", () => Utility.Pause(0.05), 1);
+            a1.AddTransition(3, "transition1", a2, Transition2);
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            // WHEN it is executed
+            bool completed = false;
+            var watch = System.Diagnostics.Stopwatch.StartNew();
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+            watch.Stop();
+
+            // THEN each pause lasted for at least its delay
+            Assert.IsTrue(completed);
+            Assert.GreaterOrEqual(watch.Elapsed.TotalSeconds, 0.1);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeDelayBetweenEvaluations()
+        {
+            // GIVEN a net whose transition becomes fulfilled after a while, and is evaluated with a delay
+            PetriNet pn = new PetriNet("Test");
+            Action a1 = new Action(1, "action1", Utility.DoNothing, 1);
+            Action a2 = new Action(2, "action2", Utility.DoNothing, 1);
+            var watch = new System.Diagnostics.Stopwatch();
+            var evaluations = new System.Collections.Generic.List<double>();
+            Transition t = a1.AddTransition(3, "transition1", a2, (System.Int32 result) => {
+                evaluations.Add(watch.Elapsed.TotalSeconds);
+                return watch.Elapsed.TotalSeconds >= 0.1;
+            });
+            t.delayBetweenEvaluation = 0.02;
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            // WHEN it is executed
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                watch.Start();
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the transition has been evaluated again until it was fulfilled, but never before its delay
+            Assert.IsTrue(completed);
+            Assert.GreaterOrEqual(evaluations.Count, 2);
+            for(int i = 1; i < evaluations.Count; ++i) {
+                Assert.GreaterOrEqual(evaluations[i] - evaluations[i - 1], 0.019);
+            }
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeMaxWorkers()
+        {
+            // GIVEN a net whose executor has at most 2 workers, and whose many initial states pause for a while
+            var executor = new Executor("Test", 1, 2);
+            PetriNet pn = new PetriNet("Test", executor);
+            int running = 0, maxRunning = 0, executed = 0;
+            for(UInt64 i = 0; i < 6; ++i) {
+                pn.AddAction(new Action(i, "action", () => {
+                    int current = System.Threading.Interlocked.Increment(ref running);
+                    lock(this) {
+                        maxRunning = System.Math.Max(maxRunning, current);
+                    }
+                    Utility.Pause(0.02);
+                    System.Threading.Interlocked.Decrement(ref running);
+                    System.Threading.Interlocked.Increment(ref executed);
+                    return 0;
+                }, 1), true);
+            }
+
+            // WHEN it is executed
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN every action has been executed, but by no more than 2 workers at once
+            Assert.IsTrue(completed);
+            Assert.AreEqual(6, executed);
+            Assert.LessOrEqual(maxRunning, 2);
+            Assert.LessOrEqual(executor.ThreadCount, 2);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeIdleWorkersExit()
+        {
+            // GIVEN a net whose executor reaps its workers idle for a short while, and whose initial states pause concurrently
+            var executor = new Executor("Test", 1, 4, 0.05);
+            PetriNet pn = new PetriNet("Test", executor);
+            UInt64 maxThreads = 0;
+            for(UInt64 i = 0; i < 4; ++i) {
+                pn.AddAction(new Action(i, "action", () => {
+                    Utility.Pause(0.05);
+                    lock(this) {
+                        maxThreads = System.Math.Max(maxThreads, executor.ThreadCount);
+                    }
+                    return 0;
+                }, 1), true);
+            }
+
+            // WHEN it has completed, and its workers have been idle for longer than their timeout
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+            var watch = System.Diagnostics.Stopwatch.StartNew();
+            while(executor.ThreadCount > 1 && watch.Elapsed.TotalSeconds < 5) {
+                System.Threading.Thread.Sleep(10);
+            }
+
+            // THEN the workers added for the concurrent states have exited, but the minimal count of workers
+            Assert.IsTrue(completed);
+            Assert.Greater(maxThreads, 1);
+            Assert.AreEqual(1, executor.ThreadCount);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeOverflowReject()
+        {
+            // GIVEN a net whose executor has a single worker and rejects the overflowing tasks, with 2 initial states
+            var executor = new Executor("Test", 1, 1, 10, OverflowPolicy.Reject);
+            PetriNet pn = new PetriNet("Test", executor);
+            int executed = 0;
+            pn.AddAction(new Action(1, "action1", () => {
+                Utility.Pause(0.05);
+                System.Threading.Interlocked.Increment(ref executed);
+                return 0;
+            }, 1), true);
+            pn.AddAction(new Action(2, "action2", () => {
+                System.Threading.Interlocked.Increment(ref executed);
+                return 0;
+            }, 1), true);
+
+            // WHEN it is executed
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the second state has been rejected, and the net completes nonetheless
+            Assert.IsTrue(completed);
+            Assert.AreEqual(1, executed);
+        }
+
+        [Test()]
+        public void TestRuntimeOverflowInline()
+        {
+            // GIVEN a net whose executor has a single worker and runs the overflowing tasks inline, with 2 initial states
+            var executor = new Executor("Test", 1, 1, 10, OverflowPolicy.Inline);
+            PetriNet pn = new PetriNet("Test", executor);
+            int thread1 = 0, thread2 = 0;
+            pn.AddAction(new Action(1, "action1", () => {
+                thread1 = System.Threading.Thread.CurrentThread.ManagedThreadId;
+                Utility.Pause(0.05);
+                return 0;
+            }, 1), true);
+            pn.AddAction(new Action(2, "action2", () => {
+                thread2 = System.Threading.Thread.CurrentThread.ManagedThreadId;
+                return 0;
+            }, 1), true);
+
+            // WHEN it is executed
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the second state has been executed by the thread running the net, and the first one by the worker
+            Assert.IsTrue(completed);
+            Assert.AreEqual(System.Threading.Thread.CurrentThread.ManagedThreadId, thread2);
+            Assert.AreNotEqual(thread2, thread1);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test(), Repeat(10)]
+        public void TestRuntimeOverflowInlineStop()
+        {
+            // GIVEN a net whose executor has a single worker and runs the overflowing tasks inline, with 2 initial states:
+            // the first one occupies the worker until the second one, run inline, has started
+            var executor = new Executor("Test", 1, 1, 10, OverflowPolicy.Inline);
+            PetriNet pn = new PetriNet("Test", executor);
+            bool inlineStarted = false, inlineEnded = false;
+            pn.AddAction(new Action(1, "action1", () => {
+                while(!inlineStarted) {
+                    System.Threading.Thread.Sleep(1);
+                }
+                return 0;
+            }, 1), true);
+            pn.AddAction(new Action(2, "action2", () => {
+                inlineStarted = true;
+                Utility.Pause(0.1);
+                inlineEnded = true;
+                return 0;
+            }, 1), true);
+
+            // WHEN the net is stopped while its inline state is running on the thread which started it
+            bool endedBeforeStop = true, ran = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                var runner = new System.Threading.Thread(() => pn.Run());
+                runner.Start();
+                while(!inlineStarted) {
+                    System.Threading.Thread.Sleep(1);
+                }
+                pn.Stop();
+                endedBeforeStop = inlineEnded;
+                ran = runner.Join(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN stopping the net has waited for the inline state, as it does for the states run by the workers
+            Assert.IsTrue(ran);
+            Assert.IsTrue(endedBeforeStop);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test(), Repeat(20)]
+        public void TestRuntimeForkJoin()
+        {
+            // GIVEN a net forking into many branches, which all join into a last state
+            const int branches = 64;
+            var executor = new Executor("Test", 1, 4);
+            PetriNet pn = new PetriNet("Test", executor);
+            var executions = new int[branches + 2];
+            Action fork = new Action(0, "fork", () => {
+                System.Threading.Interlocked.Increment(ref executions[0]);
+                return 0;
+            }, 1);
+            Action join = new Action(branches + 1, "join", () => {
+                System.Threading.Interlocked.Increment(ref executions[branches + 1]);
+                return 0;
+            }, branches);
+            pn.AddAction(fork, true);
+            for(int i = 1; i <= branches; ++i) {
+                int index = i;
+                Action branch = new Action((UInt64)i, "branch", () => {
+                    System.Threading.Interlocked.Increment(ref executions[index]);
+                    return 0;
+                }, 1);
+                fork.AddTransition((UInt64)(1000 + i), "fork", branch, Transition2);
+                branch.AddTransition((UInt64)(2000 + i), "join", join, Transition2);
+                pn.AddAction(branch, false);
+            }
+            pn.AddAction(join, false);
+
+            // WHEN it is executed by several workers
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN every action has been executed exactly once
+            Assert.IsTrue(completed);
+            for(int i = 0; i < executions.Length; ++i) {
+                Assert.AreEqual(1, executions[i]);
+            }
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeLongChainYields()
+        {
+            // GIVEN a net executed by a single worker, whose first initial state starts a long loop, and whose second one
+            // records how far the loop has gone
+            const int iterations = 1000;
+            var executor = new Executor("Test", 1, 1);
+            PetriNet pn = new PetriNet("Test", executor);
+            int loops = 0, loopsBeforeOther = -1;
+            bool started = false;
+            Action start = new Action(8, "start", () => {
+                while(!started) {
+                    System.Threading.Thread.Sleep(1);
+                }
+                return 0;
+            }, 1);
+            Action a1 = new Action(1, "loop1", () => {
+                ++loops;
+                return 0;
+            }, 1);
+            Action a2 = new Action(2, "loop2", Utility.DoNothing, 1);
+            Action end = new Action(3, "end", Utility.DoNothing, 1);
+            Action other = new Action(4, "other", () => {
+                loopsBeforeOther = loops;
+                return 0;
+            }, 1);
+            start.AddTransition(9, "transition4", a1, Transition2);
+            a1.AddTransition(5, "transition1", a2, Transition2);
+            a2.AddTransition(6, "transition2", a1, (System.Int32 result) => loops < iterations);
+            a2.AddTransition(7, "transition3", end, (System.Int32 result) => loops >= iterations);
+            pn.AddAction(start, true);
+            pn.AddAction(other, true);
+            pn.AddAction(a1, false);
+            pn.AddAction(a2, false);
+            pn.AddAction(end, false);
+
+            // WHEN it is executed, the loop starting once both initial states have been enabled
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                started = true;
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the loop has yielded its worker to the second state before it ended
+            Assert.IsTrue(completed);
+            Assert.AreEqual(iterations, loops);
+            Assert.GreaterOrEqual(loopsBeforeOther, 0);
+            Assert.Less(loopsBeforeOther, iterations);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test(), Repeat(10)]
+        public void TestRuntimeSharedExecutor()
+        {
+            // GIVEN several nets sharing an executor with 2 workers, each of them looping through its states a while
+            const int nets = 4, iterations = 100;
+            var executor = new Executor("Test", 1, 2);
+            var pns = new PetriNet[nets];
+            var loops = new int[nets];
+            for(int i = 0; i < nets; ++i) {
+                int index = i;
+                pns[i] = new PetriNet("Test" + i, executor);
+                Action a1 = new Action(1, "loop1", () => {
+                    ++loops[index];
+                    return 0;
+                }, 1);
+                Action a2 = new Action(2, "loop2", Utility.DoNothing, 1);
+                Action end = new Action(3, "end", Utility.DoNothing, 1);
+                a1.AddTransition(4, "transition1", a2, Transition2);
+                a2.AddTransition(5, "transition2", a1, (System.Int32 result) => loops[index] < iterations);
+                a2.AddTransition(6, "transition3", end, (System.Int32 result) => loops[index] >= iterations);
+                pns[i].AddAction(a1, true);
+                pns[i].AddAction(a2, false);
+                pns[i].AddAction(end, false);
+            }
+
+            // WHEN they are all executed at once
+            bool completed = true;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                foreach(var pn in pns) {
+                    pn.Run();
+                }
+                foreach(var pn in pns) {
+                    completed &= pn.JoinFor(System.TimeSpan.FromSeconds(10));
+                }
+            }, out stdout, out stderr);
+
+            // THEN each of them has completed its own loop, and the executor has not grown past its workers
+            Assert.IsTrue(completed);
+            foreach(int l in loops) {
+                Assert.AreEqual(iterations, l);
+            }
+            Assert.LessOrEqual(executor.ThreadCount, 2);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test(), Repeat(10)]
+        public void TestRuntimeExecutorFairness()
+        {
+            // GIVEN 2 nets sharing an executor with a single worker, the first one looping through its states endlessly
+            var executor = new Executor("Test", 1, 1);
+            PetriNet busy = new PetriNet("Busy", executor);
+            int loops = 0;
+            Action a1 = new Action(1, "loop1", () => {
+                ++loops;
+                return 0;
+            }, 1);
+            Action a2 = new Action(2, "loop2", Utility.DoNothing, 1);
+            a1.AddTransition(3, "transition1", a2, Transition2);
+            a2.AddTransition(4, "transition2", a1, Transition2);
+            busy.AddAction(a1, true);
+            busy.AddAction(a2, false);
+
+            PetriNet other = new PetriNet("Other", executor);
+            int loopsBeforeOther = -1;
+            other.AddAction(new Action(1, "other", () => {
+                loopsBeforeOther = loops;
+                return 0;
+            }, 1), true);
+
+            // WHEN the second net is executed once the first one has started looping
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                busy.Run();
+                while(loops == 0) {
+                    System.Threading.Thread.Sleep(1);
+                }
+                other.Run();
+                completed = other.JoinFor(System.TimeSpan.FromSeconds(10));
+                busy.Stop();
+            }, out stdout, out stderr);
+
+            // THEN the first net has yielded the worker to the second one, which has completed
+            Assert.IsTrue(completed);
+            Assert.Greater(loopsBeforeOther, 0);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeVariablesLocked()
+        {
+            // GIVEN a net whose concurrent initial states all increment the same variable
+            const int states = 8, increments = 200;
+            var executor = new Executor("Test", 1, 4);
+            PetriNet pn = new PetriNet("Test", executor);
+            pn.AddVariable(0);
+            var variable = pn.GetVariable(0);
+            for(UInt64 i = 0; i < states; ++i) {
+                Action a = new Action(i, "action", () => {
+                    for(int j = 0; j < increments; ++j) {
+                        var value = variable.Value;
+                        System.Threading.Thread.Yield();
+                        variable.Value = value + 1;
+                    }
+                    return 0;
+                }, 1);
+                a.AddVariable(0);
+                pn.AddAction(a, true);
+            }
+
+            // WHEN it is executed by several workers
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN no increment has been lost, the states having locked the variable they were given
+            Assert.IsTrue(completed);
+            Assert.AreEqual(states * increments, variable.Value);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeTokensCounted()
+        {
+            // GIVEN a net whose last state requires 2 tokens, but only gets one
+            PetriNet pn = new PetriNet("Test");
+            Action a1 = new Action(1, "action1", Utility.DoNothing, 1);
+            Action a2 = new Action(2, "action2", Utility.DoNothing, 2);
+            a1.AddTransition(3, "transition1", a2, Transition2);
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            // WHEN it is executed
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the net completes, and its last state keeps the token it got
+            Assert.IsTrue(completed);
+            Assert.AreEqual(0, a1.CurrentTokens);
+            Assert.AreEqual(1, a2.CurrentTokens);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeVariableHandle()
+        {
+            // GIVEN a net in the VariableChange evaluation mode whose second state waits for a variable to be set,
+            // and a handle to the variable
+            PetriNet pn = new PetriNet("Test");
+            pn.EvaluationMode = EvaluationMode.VariableChange;
+            pn.AddVariable(0);
+            VariableHandle handle = pn.GetVariableHandle(0);
+            Action a1 = new Action(1, "action1", Utility.DoNothing, 1);
+            Action a2 = new Action(2, "action2", Utility.DoNothing, 1);
+            Transition t = a1.AddTransition(3, "transition1", a2, (System.Int32 result) => handle.Value == 2);
+            t.AddReadVariable(0);
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            System.Int64 readBefore = -1, readAfter = -1, readThroughNet = -1;
+            bool completedBefore = true, completedAfter = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                // WHEN the variable is written through the net, and then through its handle while the state waits
+                pn.GetVariable(0).Value = 1;
+                readBefore = handle.Value;
+                pn.Run();
+                completedBefore = pn.JoinFor(System.TimeSpan.FromMilliseconds(50));
+                handle.Value = 2;
+                readAfter = handle.Value;
+                readThroughNet = pn.GetVariable(0).Value;
+                completedAfter = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the handle reads and writes the variable of the net, and its writes notify the waiting state
+            Assert.AreEqual(1, readBefore);
+            Assert.IsFalse(completedBefore);
+            Assert.AreEqual(2, readAfter);
+            Assert.AreEqual(2, readThroughNet);
+            Assert.IsTrue(completedAfter);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeTemplateInstances()
+        {
+            // GIVEN a template whose action increments the variable of the net executing it
+            PetriNet prototype = new PetriNet("Test");
+            prototype.AddVariable(0);
+            prototype.GetVariable(0).Value = 5;
+            Action a1 = new Action(1, "action1", (System.IntPtr handle) => {
+                var variable = new PetriNet(handle, false).GetVariable(0);
+                variable.Value = variable.Value + 1;
+                return 0;
+            }, 1);
+            a1.AddVariable(0);
+            Action a2 = new Action(2, "action2", Utility.DoNothing, 1);
+            a1.AddTransition(3, "transition1", a2, Transition2);
+            prototype.AddAction(a1, true);
+            prototype.AddAction(a2, false);
+            var petriNetTemplate = new PetriNetTemplate(prototype);
+
+            // WHEN several nets are instantiated from it, one of them starting from another value, and executed
+            var executor = new Executor("Test", 1, 4);
+            var instances = new PetriNet[] { petriNetTemplate.Instantiate(),
+                                             petriNetTemplate.Instantiate(executor),
+                                             petriNetTemplate.Instantiate(executor) };
+            instances[2].GetVariable(0).Value = 10;
+            bool completed = true;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                foreach(var pn in instances) {
+                    pn.Run();
+                }
+                foreach(var pn in instances) {
+                    completed = pn.JoinFor(System.TimeSpan.FromSeconds(10)) && completed;
+                }
+            }, out stdout, out stderr);
+
+            // THEN each instance has executed the states of the template on its own variables
+            Assert.IsTrue(completed);
+            Assert.AreEqual(6, instances[0].GetVariable(0).Value);
+            Assert.AreEqual(6, instances[1].GetVariable(0).Value);
+            Assert.AreEqual(11, instances[2].GetVariable(0).Value);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test(), Repeat(10)]
+        public void TestRuntimePayloadsJoined()
+        {
+            // GIVEN a net forking into several branches which each send their own payload, and which all join into a last
+            // state
+            const int branches = 4;
+            var executor = new Executor("Test", 1, 4);
+            PetriNet pn = new PetriNet("Test", executor);
+            var received = new System.Collections.Generic.List<System.Int64>();
+            Action fork = new Action(0, "fork", Utility.DoNothing, 1);
+            Action join = new Action(branches + 1, "join", (System.IntPtr handle) => {
+                var net = new PetriNet(handle, false);
+                System.Int64 value;
+                while(net.TakePayload(out value)) {
+                    received.Add(value);
+                }
+                return 0;
+            }, branches);
+            pn.AddAction(fork, true);
+            for(int i = 1; i <= branches; ++i) {
+                int index = i;
+                Action branch = new Action((UInt64)i, "branch", (System.IntPtr handle) => {
+                    new PetriNet(handle, false).SendPayload(10 * index);
+                    return 0;
+                }, 1);
+                fork.AddTransition((UInt64)(1000 + i), "fork", branch, Transition2);
+                branch.AddTransition((UInt64)(2000 + i), "join", join, Transition2);
+                pn.AddAction(branch, false);
+            }
+            pn.AddAction(join, false);
+
+            // WHEN it is executed
+            bool completed = false;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                pn.Run();
+                completed = pn.JoinFor(System.TimeSpan.FromSeconds(10));
+            }, out stdout, out stderr);
+
+            // THEN the last state has received the payload of every branch once
+            Assert.IsTrue(completed);
+            received.Sort();
+            CollectionAssert.AreEqual(new System.Int64[] { 10, 20, 30, 40 }, received);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeBatch()
+        {
+            // GIVEN a template whose first state increments the variable of the net executing it, and loops until it
+            // has reached 3
+            PetriNet prototype = new PetriNet("Test");
+            prototype.AddVariable(0);
+            Action a1 = new Action(1, "action1", (System.IntPtr handle) => {
+                var variable = new PetriNet(handle, false).GetVariable(0);
+                variable.Value = variable.Value + 1;
+                return (System.Int32)variable.Value;
+            }, 1);
+            a1.AddVariable(0);
+            Action a2 = new Action(2, "action2", Utility.DoNothing, 1);
+            Action end = new Action(3, "end", Utility.DoNothing, 1);
+            a1.AddTransition(4, "transition1", a2, (System.Int32 result) => result < 3);
+            a1.AddTransition(5, "transition2", end, (System.Int32 result) => result >= 3);
+            a2.AddTransition(6, "transition3", a1, Transition2);
+            prototype.AddAction(a1, true);
+            prototype.AddAction(a2, false);
+            prototype.AddAction(end, false);
+            var petriNetTemplate = new PetriNetTemplate(prototype);
+
+            // WHEN a batch of instances is run from it until it is quiescent, one of the instances starting from
+            // another value
+            var batch = new PetriNetBatch(petriNetTemplate, 4);
+            batch.SetValue(0, 3, 5);
+            UInt64 activeBefore = 0;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                batch.Run();
+                activeBefore = batch.ActiveInstances;
+                batch.RunUntilQuiescent();
+            }, out stdout, out stderr);
+
+            // THEN each instance has executed the states of the template on its own variables, and has completed
+            Assert.AreEqual(4, batch.Size);
+            Assert.AreEqual(4, activeBefore);
+            Assert.AreEqual(0, batch.ActiveInstances);
+            for(UInt64 i = 0; i < 3; ++i) {
+                Assert.IsTrue(batch.Completed(i));
+                Assert.AreEqual(3, batch.GetValue(0, i));
+            }
+            Assert.IsTrue(batch.Completed(3));
+            Assert.AreEqual(6, batch.GetValue(0, 3));
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeDeterministicSteps()
+        {
+            // GIVEN a deterministic net whose states are chained, and record the thread executing them
+            PetriNet pn = new PetriNet("Test");
+            pn.ExecutionMode = ExecutionMode.Deterministic;
+            var executed = new System.Collections.Generic.List<int>();
+            var threads = new System.Collections.Generic.HashSet<int>();
+            var actions = new Action[3];
+            for(int i = 0; i < actions.Length; ++i) {
+                int index = i;
+                actions[i] = new Action((UInt64)i, "action", () => {
+                    executed.Add(index);
+                    threads.Add(System.Threading.Thread.CurrentThread.ManagedThreadId);
+                    return 0;
+                }, 1);
+                pn.AddAction(actions[i], i == 0);
+            }
+            actions[0].AddTransition(10, "transition1", actions[1], Transition2);
+            actions[1].AddTransition(11, "transition2", actions[2], Transition2);
+
+            bool stepped = false, completedAfterStep = true, completed = false;
+            UInt64 steps = 0;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                // WHEN it is stepped once, and then until it is quiescent
+                pn.Run();
+                stepped = pn.Step();
+                completedAfterStep = pn.JoinFor(System.TimeSpan.Zero);
+                steps = pn.RunUntilQuiescent();
+                completed = pn.JoinFor(System.TimeSpan.Zero);
+            }, out stdout, out stderr);
+
+            // THEN a single state is executed by the first step, and the other ones in order by the calling thread
+            Assert.IsTrue(stepped);
+            Assert.IsFalse(completedAfterStep);
+            Assert.AreEqual(2, steps);
+            Assert.IsTrue(completed);
+            Assert.AreEqual(new int[] { 0, 1, 2 }, executed.ToArray());
+            Assert.AreEqual(1, threads.Count);
+            Assert.IsTrue(threads.Contains(System.Threading.Thread.CurrentThread.ManagedThreadId));
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeDeterministicQuiescence()
+        {
+            // GIVEN a deterministic net whose second state waits for a variable to be set
+            PetriNet pn = new PetriNet("Test");
+            pn.ExecutionMode = ExecutionMode.Deterministic;
+            pn.AddVariable(0);
+            var variable = pn.GetVariable(0);
+            Action a1 = new Action(1, "action1", Utility.DoNothing, 1);
+            Action a2 = new Action(2, "action2", Utility.DoNothing, 1);
+            Transition t = a1.AddTransition(3, "transition1", a2, (System.Int32 result) => variable.Value == 1);
+            t.AddReadVariable(0);
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            bool completedBefore = true, completedAfter = false;
+            UInt64 stepsBefore = 0;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                // WHEN it is run until it is quiescent, before and after the variable is set
+                pn.Run();
+                stepsBefore = pn.RunUntilQuiescent();
+                completedBefore = pn.JoinFor(System.TimeSpan.Zero);
+                variable.Value = 1;
+                pn.RunUntilQuiescent();
+                completedAfter = pn.JoinFor(System.TimeSpan.Zero);
+            }, out stdout, out stderr);
+
+            // THEN it first stops waiting for the transition, and then completes
+            Assert.AreEqual(1, stepsBefore);
+            Assert.IsFalse(completedBefore);
+            Assert.IsTrue(completedAfter);
+            Assert.IsEmpty(stderr);
+        }
+
+        [Test()]
+        public void TestRuntimeSimulatedPauses()
+        {
+            // GIVEN a simulated net, whose first state pauses for 1 second and whose final state pauses for 2 seconds
+            PetriNet pn = new PetriNet("Test");
+            pn.ExecutionMode = ExecutionMode.Simulated;
+            Action a1 = new Action(1, "action1", () => {
+                Utility.Pause(1);
+                return 0;
+            }, 1);
+            Action a2 = new Action(2, "action2", () => {
+                Utility.Pause(2);
+                return 0;
+            }, 1);
+            a1.AddTransition(3, "transition1", a2, Transition2);
+            pn.AddAction(a1, true);
+            pn.AddAction(a2, false);
+
+            bool completedBefore = true, completedAfter = false;
+            double timeBefore = 0, timeAfter = 0;
+            string stdout, stderr;
+            CompilerUtility.InvokeAndRedirectOutput(() => {
+                // WHEN its virtual time is advanced into the pause of the final state, and then past its end
+                pn.Run();
+                pn.Advance(2.5);
+                completedBefore = pn.JoinFor(System.TimeSpan.Zero);
+                timeBefore = pn.VirtualTime;
+                pn.Advance(10);
+                completedAfter = pn.JoinFor(System.TimeSpan.Zero);
+                timeAfter = pn.VirtualTime;
+            }, out stdout, out stderr);
+
+            // THEN the net only completes once both pauses have elapsed
+            Assert.IsFalse(completedBefore);
+            Assert.AreEqual(2.5, timeBefore, 1e-9);
+            Assert.IsTrue(completedAfter);
+            Assert.AreEqual(3, timeAfter, 1e-9);
+            Assert.IsEmpty(stderr);
+        }
+
         [Test(), Repeat(10)]
         public void TestRuntimeActionProperties()
         {
@@ -147,5 +1075,6 @@ namespace Petri.Test
 
 
         static volatile int counter;
+        static int executedActions;
     }
 }
@@ -166,6 +166,14 @@ void PetriAction_setName(struct PetriAction *action, char const *name);
  */
 void PetriAction_addVariable(struct PetriAction *action, uint32_t id);
 
+/**
+ * References the variable in the action, which only reads it. The variable is then shared with the
+ * other entities reading it while the action is executed.
+ * @param action The action
+ * @param id The identifier of the variable
+ */
+void PetriAction_addReadVariable(struct PetriAction *action, uint32_t id);
+
 #ifdef __cplusplus
 }
 #endif
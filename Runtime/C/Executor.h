@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  Executor.h
+//  Petri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_Executor_C
+#define Petri_Executor_C
+
+#include "Types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates an executor, whose worker threads execute the actions of the PetriNet created with it.
+ * Workers are added on demand, up to maxWorkers, and the ones idle for longer than usIdleTimeout exit
+ * as long as there are more than minWorkers.
+ * @param name The name given to the worker threads, or a designated one if empty or NULL
+ * @param minWorkers The count of workers kept alive.
+ * @param maxWorkers The maximum count of workers, or 0 for no limit.
+ * @param usIdleTimeout The delay after which an idle worker exits, in microseconds.
+ * @param overflowPolicy What to do with the task of an action when all of the workers are busy and
+ * none can be added.
+ * @return The executor instance.
+ */
+struct PetriExecutor *PetriExecutor_create(char const *name, uint64_t minWorkers, uint64_t maxWorkers, uint64_t usIdleTimeout, Petri_overflowPolicy_t overflowPolicy);
+
+/**
+ * Destroys an executor handle. The executor itself is only destroyed once all of its nets have been.
+ * @param executor The executor handle to destroy.
+ */
+void PetriExecutor_destroy(struct PetriExecutor *executor);
+
+/**
+ * Returns the current count of worker threads of the executor.
+ * @param executor The executor to query.
+ */
+uint64_t PetriExecutor_threadCount(struct PetriExecutor *executor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* Petri_Executor_C */
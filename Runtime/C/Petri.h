@@ -31,7 +31,10 @@
 #define Petri_C_h
 
 #include "Action.h"
+#include "Executor.h"
 #include "PetriNet.h"
+#include "PetriNetBatch.h"
+#include "PetriNetTemplate.h"
 #include "PetriUtils.h"
 #include "Transition.h"
 
@@ -41,6 +41,8 @@ extern "C" {
 
 // typedef struct PetriNet PetriNet;
 
+typedef void (*completionCallable_t)(struct PetriNet *);
+
 /**
  * Creates the PetriNet, assigning it a name which serves debug purposes
  * @param name The name to assign to the PetriNet, or a designated one if empty or NULL
@@ -48,6 +50,23 @@ extern "C" {
  */
 struct PetriNet *PetriNet_create(char const *name);
 
+/**
+ * Creates the PetriNet, whose actions are executed by the worker threads shared by all of the nets
+ * of the process created this way.
+ * @param name The name to assign to the PetriNet, or a designated one if empty or NULL
+ * @return The PetriNet instance, or NULL if an error occurred.
+ */
+struct PetriNet *PetriNet_createShared(char const *name);
+
+/**
+ * Creates the PetriNet, whose actions are executed by the worker threads of an executor, which may be
+ * shared with other nets. The overflow policy of the executor applies to the net.
+ * @param name The name to assign to the PetriNet, or a designated one if empty or NULL
+ * @param executor The executor of the net, which it keeps alive.
+ * @return The PetriNet instance, or NULL if an error occurred.
+ */
+struct PetriNet *PetriNet_createWithExecutor(char const *name, struct PetriExecutor *executor);
+
 /**
  * Creates the PetriNet, along with some debugging facilities.
  * @param name The name to assign to the PetriNet, or a designated one if empty or NULL
@@ -98,6 +117,95 @@ void PetriNet_stop(struct PetriNet *pn);
  */
 void PetriNet_join(struct PetriNet *pn);
 
+/**
+ * Blocks the calling thread until the Petri net has completed its whole execution, or until the
+ * timeout expires.
+ * @param pn The Petri Net to join.
+ * @param usTimeout The maximum duration to wait for, in microseconds.
+ * @return true if the net has completed its execution, false if the timeout expired. A timeout of 0
+ * only checks for completion.
+ */
+bool PetriNet_joinFor(struct PetriNet *pn, uint64_t usTimeout);
+
+/**
+ * Registers a callback invoked once the Petri net has completed its whole execution, on the thread
+ * that stopped it. If the net is not running, the callback is invoked immediately. The callback must
+ * neither destroy nor stop the net.
+ * @param pn The Petri Net to watch.
+ * @param callback The callback to invoke, with pn as its argument.
+ */
+void PetriNet_onCompletion(struct PetriNet *pn, completionCallable_t callback);
+
+/**
+ * Changes the way the transitions of the active states of the Petri net are evaluated again. The net
+ * must not be running. In the Petri_EvaluationMode_VariableChange mode, the condition of a transition
+ * associated to variables must only depend on these variables and on the result of the previous
+ * action.
+ * @param pn The Petri Net to configure.
+ * @param mode The new evaluation mode.
+ */
+void PetriNet_setEvaluationMode(struct PetriNet *pn, Petri_evaluationMode_t mode);
+
+/**
+ * Returns the way the transitions of the active states of the Petri net are evaluated again.
+ * @param pn The Petri Net to query.
+ */
+Petri_evaluationMode_t PetriNet_getEvaluationMode(struct PetriNet *pn);
+
+/**
+ * Changes which threads execute the states of the Petri net. The net must not be running.
+ * @param pn The Petri Net to configure.
+ * @param mode The new execution mode.
+ */
+void PetriNet_setExecutionMode(struct PetriNet *pn, Petri_executionMode_t mode);
+
+/**
+ * Returns which threads execute the states of the Petri net.
+ * @param pn The Petri Net to query.
+ */
+Petri_executionMode_t PetriNet_getExecutionMode(struct PetriNet *pn);
+
+/**
+ * Performs the steps of a simulated Petri net which are due before its virtual clock has advanced
+ * by the specified duration, and then sets the clock to the end of that duration.
+ * @param pn The Petri Net to step.
+ * @param usduration The duration to simulate, in microseconds.
+ * @return The count of steps performed.
+ */
+uint64_t PetriNet_advance(struct PetriNet *pn, uint64_t usduration);
+
+/**
+ * Returns the virtual time elapsed since a simulated Petri net was started.
+ * @param pn The Petri Net to query.
+ * @return The virtual time, in microseconds.
+ */
+uint64_t PetriNet_virtualTime(struct PetriNet *pn);
+
+/**
+ * Performs a single step of a Petri net running in the deterministic mode, on the calling thread.
+ * The oldest enabled state executes its action, and its transitions are evaluated. If no state is
+ * enabled, the pending transitions are evaluated again.
+ * @param pn The Petri Net to step.
+ * @return false if the net is not running or nothing could be done, true otherwise.
+ */
+bool PetriNet_step(struct PetriNet *pn);
+
+/**
+ * Performs at most count steps of a Petri net running in the deterministic mode.
+ * @param pn The Petri Net to step.
+ * @param count The maximum count of steps.
+ * @return The count of steps performed.
+ */
+uint64_t PetriNet_stepCount(struct PetriNet *pn, uint64_t count);
+
+/**
+ * Steps a Petri net running in the deterministic mode until it either completes, or waits for
+ * transitions which are not fulfilled.
+ * @param pn The Petri Net to step.
+ * @return The count of steps performed.
+ */
+uint64_t PetriNet_runUntilQuiescent(struct PetriNet *pn);
+
 /**
  * Adds an Atomic variable designated by the specified id.
  * @param pn The Petri Net to add the variable to.
@@ -138,12 +246,60 @@ void PetriNet_lockVariable(struct PetriNet *pn, uint32_t id);
 
 /**
  * Unlocks the Atomic variable designated by the specified id, provided it has already been locked.
- * The behavior is unspecified otherwise.
+ * The behavior is unspecified otherwise. The transitions waiting on the variable are notified of its
+ * possible change.
  * @param pn The Petri Net containing the variable to unlock.
  * @param id The id of the Atomic variable.
  */
 void PetriNet_unlockVariable(struct PetriNet *pn, uint32_t id);
 
+/**
+ * Resolves once the Atomic variable designated by the specified id, so that it is not looked up
+ * again on each access. The handle remains valid as long as the Petri net, and must be destroyed
+ * with PetriVariable_destroy().
+ * @param pn The Petri Net that contains the variable.
+ * @param id The id of the Atomic variable.
+ * @return The handle of the Atomic variable.
+ */
+struct PetriVariable *PetriNet_getVariableHandle(struct PetriNet *pn, uint32_t id);
+
+/**
+ * Destroys a variable handle. The variable itself is left untouched.
+ * @param variable The variable handle to destroy.
+ */
+void PetriVariable_destroy(struct PetriVariable *variable);
+
+/**
+ * Gets the value of the Atomic variable designated by the handle.
+ * @param variable The handle of the variable.
+ * @return The value of the Atomic variable.
+ */
+int64_t PetriVariable_getValue(struct PetriVariable *variable);
+
+/**
+ * Sets the value of the Atomic variable designated by the handle to the given value.
+ * @param variable The handle of the variable.
+ * @param value The value of the Atomic variable.
+ */
+void PetriVariable_setValue(struct PetriVariable *variable, int64_t value);
+
+/**
+ * Attaches a payload holding an integer to the token sent by the action executed by the calling
+ * thread, replacing the previous one if any. Must only be called by an action of the net.
+ * @param pn The Petri Net executing the action.
+ * @param value The value carried by the token.
+ */
+void PetriNet_sendPayload(struct PetriNet *pn, int64_t value);
+
+/**
+ * Takes the next payload of the tokens which activated the action executed by the calling thread.
+ * Must only be called by an action of the net.
+ * @param pn The Petri Net executing the action.
+ * @param value Receives the value carried by the token.
+ * @return false if no payload is left, or if the payload taken does not hold an integer.
+ */
+bool PetriNet_takePayload(struct PetriNet *pn, int64_t *value);
+
 char const *PetriNet_getName(struct PetriNet *pn);
 
 #ifdef __cplusplus
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetBatch.h
+//  Petri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_PetriNetBatch_C
+#define Petri_PetriNetBatch_C
+
+#include "PetriNetTemplate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates a batch executing any count of independent instances of the net of a template on the
+ * calling thread, as in the Deterministic execution mode. The variables of the instances hold the
+ * values of the variables of the prototype, and the pauses of the actions are ignored.
+ * @param petriNetTemplate The template of the instances, which may be destroyed afterwards.
+ * @param instances The count of instances.
+ * @return The batch, or NULL if an error occurred.
+ */
+struct PetriNetBatch *PetriNetBatch_create(struct PetriNetTemplate *petriNetTemplate, uint64_t instances);
+
+/**
+ * Destroys a batch.
+ * @param batch The batch to destroy.
+ */
+void PetriNetBatch_destroy(struct PetriNetBatch *batch);
+
+/**
+ * Returns the count of instances of a batch.
+ * @param batch The batch.
+ */
+uint64_t PetriNetBatch_size(struct PetriNetBatch *batch);
+
+/**
+ * Returns the value of a variable in an instance of a batch.
+ * @param batch The batch.
+ * @param id The ID of the variable.
+ * @param instance The index of the instance.
+ */
+int64_t PetriNetBatch_getValue(struct PetriNetBatch *batch, uint32_t id, uint64_t instance);
+
+/**
+ * Sets the value of a variable in an instance of a batch, which is done before it is run or
+ * between two steps.
+ * @param batch The batch.
+ * @param id The ID of the variable.
+ * @param instance The index of the instance.
+ * @param value The new value of the variable.
+ */
+void PetriNetBatch_setValue(struct PetriNetBatch *batch, uint32_t id, uint64_t instance, int64_t value);
+
+/**
+ * Starts every instance of a batch from the initial states of the net, which is done again if the
+ * batch has already been run. The variables are left as they are.
+ * @param batch The batch to run.
+ */
+void PetriNetBatch_run(struct PetriNetBatch *batch);
+
+/**
+ * Performs a sweep across the instances of a batch.
+ * @param batch The batch to step.
+ * @return The count of actions executed and transitions crossed, which is 0 once no instance can
+ * progress anymore.
+ */
+uint64_t PetriNetBatch_step(struct PetriNetBatch *batch);
+
+/**
+ * Performs sweeps until no instance of a batch can progress anymore.
+ * @param batch The batch to step.
+ * @return The count of sweeps performed.
+ */
+uint64_t PetriNetBatch_runUntilQuiescent(struct PetriNetBatch *batch);
+
+/**
+ * Returns the count of instances of a batch which have not completed yet.
+ * @param batch The batch.
+ */
+uint64_t PetriNetBatch_activeInstances(struct PetriNetBatch *batch);
+
+/**
+ * Checks whether an instance of a batch has completed, i.e. has no active state left.
+ * @param batch The batch.
+ * @param instance The index of the instance.
+ */
+bool PetriNetBatch_completed(struct PetriNetBatch *batch, uint64_t instance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* Petri_PetriNetBatch_C */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetTemplate.h
+//  Petri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_PetriNetTemplate_C
+#define Petri_PetriNetTemplate_C
+
+#include "Executor.h"
+#include "PetriNet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates a template from a net, filled with its states, transitions and variables, from which any
+ * count of nets can be instantiated. The instances share the states and transitions of the template,
+ * whose callables are invoked concurrently by the instances.
+ * @param prototype The net, which must have been created by a PetriNet_create* function and must not
+ * be running. It becomes the prototype of the instances, and the handle is destroyed.
+ * @return The template, or NULL if an error occurred.
+ */
+struct PetriNetTemplate *PetriNetTemplate_create(struct PetriNet *prototype);
+
+/**
+ * Destroys a template. The nets instantiated from it remain valid.
+ * @param petriNetTemplate The template to destroy.
+ */
+void PetriNetTemplate_destroy(struct PetriNetTemplate *petriNetTemplate);
+
+/**
+ * Creates a net executing the states and transitions of the template. Its variables are created with
+ * the values of the ones of the prototype, and its actions are executed by the executor of the
+ * prototype. No action can be added to the net, which is destroyed with PetriNet_destroy().
+ * @param petriNetTemplate The template to instantiate.
+ * @return The new net.
+ */
+struct PetriNet *PetriNetTemplate_instantiate(struct PetriNetTemplate *petriNetTemplate);
+
+/**
+ * Creates a net executing the states and transitions of the template, as PetriNetTemplate_instantiate()
+ * does, whose actions are executed by the specified executor.
+ * @param petriNetTemplate The template to instantiate.
+ * @param executor The executor of the net.
+ * @return The new net.
+ */
+struct PetriNet *PetriNetTemplate_instantiateWithExecutor(struct PetriNetTemplate *petriNetTemplate, struct PetriExecutor *executor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* Petri_PetriNetTemplate_C */
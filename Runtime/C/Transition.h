@@ -125,6 +125,14 @@ void PetriTransition_setDelayBetweenEvaluation(struct PetriTransition *transitio
  */
 void PetriTransition_addVariable(struct PetriTransition *transition, uint32_t id);
 
+/**
+ * References the variable in the transition, which only reads it. The variable is then shared with
+ * the other entities reading it while the transition is evaluated.
+ * @param transition The transition
+ * @param id The identifier of the variable
+ */
+void PetriTransition_addReadVariable(struct PetriTransition *transition, uint32_t id);
+
 #ifdef __cplusplus
 }
 #endif
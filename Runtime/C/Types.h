@@ -34,4 +34,44 @@
 
 typedef int32_t Petri_actionResult_t;
 
+/**
+ * The way the transitions of the active states of a petri net are evaluated again after a failed
+ * evaluation, as Petri::PetriNet::EvaluationMode.
+ */
+typedef enum {
+    // Every transition is periodically evaluated, according to its delay between evaluations.
+    Petri_EvaluationMode_Polling,
+    // The transitions which depend on variables are only evaluated again when one of these variables
+    // changes.
+    Petri_EvaluationMode_VariableChange
+} Petri_evaluationMode_t;
+
+/**
+ * Which threads execute the states of a petri net, as Petri::PetriNet::ExecutionMode.
+ */
+typedef enum {
+    // The states are executed concurrently by the worker threads of the net.
+    Petri_ExecutionMode_Concurrent,
+    // The states are executed one at a time and in a reproducible order, by the thread stepping the
+    // net. The variables are not locked, and must not be accessed by any other thread while the net
+    // is running.
+    Petri_ExecutionMode_Deterministic,
+    // The states are executed as in the deterministic mode, against a virtual clock which is advanced
+    // by the pauses of the actions and the delays between the evaluations of the transitions.
+    Petri_ExecutionMode_Simulated
+} Petri_executionMode_t;
+
+/**
+ * What happens to the task of an action when all of the worker threads of an executor are busy and
+ * none can be added, as Petri::WorkerOptions::OverflowPolicy.
+ */
+typedef enum {
+    // The task waits for a worker to be available.
+    Petri_OverflowPolicy_Queue,
+    // The task is dropped.
+    Petri_OverflowPolicy_Reject,
+    // The task is executed by the thread adding it.
+    Petri_OverflowPolicy_Inline
+} Petri_overflowPolicy_t;
+
 #endif /* Types_h */
@@ -114,3 +114,7 @@ void PetriAction_setName(PetriAction *action, char const *name) {
 void PetriAction_addVariable(PetriAction *action, uint32_t id) {
     getAction(action).addVariable(id);
 }
+
+void PetriAction_addReadVariable(PetriAction *action, uint32_t id) {
+    getAction(action).addVariable(id, Petri::VariableAccess::Read);
+}
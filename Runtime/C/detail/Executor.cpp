@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  Executor.cpp
+//  Petri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "../../Cpp/Executor.h"
+#include "../Executor.h"
+#include "Types.hpp"
+
+static_assert(Petri_OverflowPolicy_Queue == static_cast<int>(Petri::WorkerOptions::OverflowPolicy::Queue) &&
+              Petri_OverflowPolicy_Reject == static_cast<int>(Petri::WorkerOptions::OverflowPolicy::Reject) &&
+              Petri_OverflowPolicy_Inline == static_cast<int>(Petri::WorkerOptions::OverflowPolicy::Inline),
+              "The overflow policies of the C API must mirror the C++ ones!");
+
+PetriExecutor *PetriExecutor_create(char const *name,
+                                    uint64_t minWorkers,
+                                    uint64_t maxWorkers,
+                                    uint64_t usIdleTimeout,
+                                    Petri_overflowPolicy_t overflowPolicy) {
+    Petri::WorkerOptions options;
+    options.minWorkers = minWorkers;
+    if(maxWorkers > 0) {
+        options.maxWorkers = maxWorkers;
+    }
+    options.idleTimeout = std::chrono::microseconds(usIdleTimeout);
+    options.overflowPolicy = static_cast<Petri::WorkerOptions::OverflowPolicy>(overflowPolicy);
+
+    return new PetriExecutor{std::make_shared<Petri::Executor>(options, name && *name ? name : "Petri executor")};
+}
+
+void PetriExecutor_destroy(PetriExecutor *executor) {
+    delete executor;
+}
+
+uint64_t PetriExecutor_threadCount(PetriExecutor *executor) {
+    return executor->executor->threadCount();
+}
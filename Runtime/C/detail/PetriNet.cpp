@@ -29,6 +29,7 @@
 
 #include "../../Cpp/Action.h"
 #include "../../Cpp/Atomic.h"
+#include "../../Cpp/Executor.h"
 #include "../../Cpp/PetriDebug.h"
 #include "../../Cpp/PetriNet.h"
 #include "../Action.h"
@@ -42,6 +43,14 @@ PetriNet *PetriNet_create(char const *name) {
     return new PetriNet{std::make_unique<Petri::PetriNet>(name ? name : "")};
 }
 
+PetriNet *PetriNet_createShared(char const *name) {
+    return new PetriNet{std::make_unique<Petri::PetriNet>(name ? name : "", Petri::Executor::shared())};
+}
+
+PetriNet *PetriNet_createWithExecutor(char const *name, PetriExecutor *executor) {
+    return new PetriNet{std::make_unique<Petri::PetriNet>(name ? name : "", executor->executor)};
+}
+
 PetriNet *PetriNet_createDebug(char const *name) {
     return new PetriNet{std::make_unique<Petri::PetriDebug>(name ? name : "")};
 }
@@ -76,6 +85,66 @@ void PetriNet_join(PetriNet *pn) {
     getPetriNet(pn).join();
 }
 
+bool PetriNet_joinFor(PetriNet *pn, uint64_t usTimeout) {
+    // Longer timeouts would overflow the deadline computation, and are as good as no timeout.
+    auto const maxTimeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::hours(24 * 365));
+    if(usTimeout >= static_cast<uint64_t>(maxTimeout.count())) {
+        getPetriNet(pn).join();
+        return true;
+    }
+
+    return getPetriNet(pn).joinFor(std::chrono::microseconds(usTimeout));
+}
+
+void PetriNet_onCompletion(PetriNet *pn, completionCallable_t callback) {
+    getPetriNet(pn).onCompletion([pn, callback]() { callback(pn); });
+}
+
+static_assert(Petri_EvaluationMode_Polling == static_cast<int>(Petri::PetriNet::EvaluationMode::Polling) &&
+              Petri_EvaluationMode_VariableChange == static_cast<int>(Petri::PetriNet::EvaluationMode::VariableChange),
+              "The evaluation modes of the C API must mirror the C++ ones!");
+
+void PetriNet_setEvaluationMode(PetriNet *pn, Petri_evaluationMode_t mode) {
+    getPetriNet(pn).setEvaluationMode(static_cast<Petri::PetriNet::EvaluationMode>(mode));
+}
+
+Petri_evaluationMode_t PetriNet_getEvaluationMode(PetriNet *pn) {
+    return static_cast<Petri_evaluationMode_t>(getPetriNet(pn).evaluationMode());
+}
+
+static_assert(Petri_ExecutionMode_Concurrent == static_cast<int>(Petri::PetriNet::ExecutionMode::Concurrent) &&
+              Petri_ExecutionMode_Deterministic == static_cast<int>(Petri::PetriNet::ExecutionMode::Deterministic) &&
+              Petri_ExecutionMode_Simulated == static_cast<int>(Petri::PetriNet::ExecutionMode::Simulated),
+              "The execution modes of the C API must mirror the C++ ones!");
+
+void PetriNet_setExecutionMode(PetriNet *pn, Petri_executionMode_t mode) {
+    getPetriNet(pn).setExecutionMode(static_cast<Petri::PetriNet::ExecutionMode>(mode));
+}
+
+Petri_executionMode_t PetriNet_getExecutionMode(PetriNet *pn) {
+    return static_cast<Petri_executionMode_t>(getPetriNet(pn).executionMode());
+}
+
+uint64_t PetriNet_advance(PetriNet *pn, uint64_t usduration) {
+    return getPetriNet(pn).advance(std::chrono::microseconds(usduration));
+}
+
+uint64_t PetriNet_virtualTime(PetriNet *pn) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(getPetriNet(pn).virtualTime()).count();
+}
+
+bool PetriNet_step(PetriNet *pn) {
+    return getPetriNet(pn).step();
+}
+
+uint64_t PetriNet_stepCount(PetriNet *pn, uint64_t count) {
+    return getPetriNet(pn).step(static_cast<std::size_t>(std::min<uint64_t>(count, std::numeric_limits<std::size_t>::max())));
+}
+
+uint64_t PetriNet_runUntilQuiescent(PetriNet *pn) {
+    return getPetriNet(pn).runUntilQuiescent();
+}
+
 void PetriNet_addVariable(PetriNet *pn, uint32_t id) {
     getPetriNet(pn).addVariable(id);
 }
@@ -89,7 +158,9 @@ int64_t PetriNet_getVariableValue(struct PetriNet *pn, uint32_t id) {
 }
 
 void PetriNet_setVariableValue(struct PetriNet *pn, uint32_t id, int64_t value) {
-    *PetriNet_getVariable(pn, id) = value;
+    auto &variable = getPetriNet(pn).getVariable(id);
+    variable.value() = value;
+    variable.notifyChange();
 }
 
 void PetriNet_lockVariable(PetriNet *pn, uint32_t id) {
@@ -97,7 +168,41 @@ void PetriNet_lockVariable(PetriNet *pn, uint32_t id) {
 }
 
 void PetriNet_unlockVariable(PetriNet *pn, uint32_t id) {
-    getPetriNet(pn).getVariable(id).getMutex().unlock();
+    auto &variable = getPetriNet(pn).getVariable(id);
+    variable.getMutex().unlock();
+    variable.notifyChange();
+}
+
+PetriVariable *PetriNet_getVariableHandle(PetriNet *pn, uint32_t id) {
+    return new PetriVariable{getPetriNet(pn).variableHandle(id)};
+}
+
+void PetriVariable_destroy(PetriVariable *variable) {
+    delete variable;
+}
+
+int64_t PetriVariable_getValue(PetriVariable *variable) {
+    return variable->handle.value();
+}
+
+void PetriVariable_setValue(PetriVariable *variable, int64_t value) {
+    variable->handle.value() = value;
+    variable->handle->notifyChange();
+}
+
+void PetriNet_sendPayload(PetriNet *pn, int64_t value) {
+    auto &petriNet = getPetriNet(pn);
+    petriNet.sendPayload(petriNet.makePayload<int64_t>(value));
+}
+
+bool PetriNet_takePayload(PetriNet *pn, int64_t *value) {
+    auto payload = getPetriNet(pn).takePayload();
+    if(auto received = payload.get<int64_t>()) {
+        *value = *received;
+        return true;
+    }
+
+    return false;
 }
 
 char const *PetriNet_getName(PetriNet *pn) {
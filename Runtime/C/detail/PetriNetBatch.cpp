@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetBatch.cpp
+//  Petri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "../../Cpp/PetriNetBatch.h"
+#include "../PetriNetBatch.h"
+#include "Types.hpp"
+#include <iostream>
+
+PetriNetBatch *PetriNetBatch_create(PetriNetTemplate *petriNetTemplate, uint64_t instances) {
+    try {
+        return new PetriNetBatch{std::make_unique<Petri::PetriNetBatch>(*petriNetTemplate->petriNetTemplate,
+                                                                        static_cast<std::size_t>(instances))};
+    } catch(std::exception const &e) {
+        std::cerr << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+void PetriNetBatch_destroy(PetriNetBatch *batch) {
+    delete batch;
+}
+
+uint64_t PetriNetBatch_size(PetriNetBatch *batch) {
+    return batch->batch->size();
+}
+
+int64_t PetriNetBatch_getValue(PetriNetBatch *batch, uint32_t id, uint64_t instance) {
+    return batch->batch->values(id)[instance];
+}
+
+void PetriNetBatch_setValue(PetriNetBatch *batch, uint32_t id, uint64_t instance, int64_t value) {
+    batch->batch->values(id)[instance] = value;
+}
+
+void PetriNetBatch_run(PetriNetBatch *batch) {
+    batch->batch->run();
+}
+
+uint64_t PetriNetBatch_step(PetriNetBatch *batch) {
+    return batch->batch->step();
+}
+
+uint64_t PetriNetBatch_runUntilQuiescent(PetriNetBatch *batch) {
+    return batch->batch->runUntilQuiescent();
+}
+
+uint64_t PetriNetBatch_activeInstances(PetriNetBatch *batch) {
+    return batch->batch->activeInstances();
+}
+
+bool PetriNetBatch_completed(PetriNetBatch *batch, uint64_t instance) {
+    return batch->batch->completed(static_cast<std::size_t>(instance));
+}
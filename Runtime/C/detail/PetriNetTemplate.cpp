@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetTemplate.cpp
+//  Petri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "../../Cpp/PetriNetTemplate.h"
+#include "../PetriNetTemplate.h"
+#include "Types.hpp"
+#include <iostream>
+
+PetriNetTemplate *PetriNetTemplate_create(PetriNet *prototype) {
+    if(!prototype->owned) {
+        std::cerr << "Only a petri net created by a PetriNet_create* function can become a template!" << std::endl;
+        return nullptr;
+    }
+
+    auto petriNetTemplate = new PetriNetTemplate{std::make_unique<Petri::PetriNetTemplate>(std::move(prototype->owned))};
+    delete prototype;
+
+    return petriNetTemplate;
+}
+
+void PetriNetTemplate_destroy(PetriNetTemplate *petriNetTemplate) {
+    delete petriNetTemplate;
+}
+
+PetriNet *PetriNetTemplate_instantiate(PetriNetTemplate *petriNetTemplate) {
+    return new PetriNet{petriNetTemplate->petriNetTemplate->instantiate(), nullptr};
+}
+
+PetriNet *PetriNetTemplate_instantiateWithExecutor(PetriNetTemplate *petriNetTemplate, PetriExecutor *executor) {
+    return new PetriNet{petriNetTemplate->petriNetTemplate->instantiate(executor->executor), nullptr};
+}
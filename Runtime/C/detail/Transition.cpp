@@ -87,3 +87,7 @@ void PetriTransition_setDelayBetweenEvaluation(PetriTransition *transition, uint
 void PetriTransition_addVariable(struct PetriTransition *transition, uint32_t id) {
     getTransition(transition).addVariable(id);
 }
+
+void PetriTransition_addReadVariable(struct PetriTransition *transition, uint32_t id) {
+    getTransition(transition).addVariable(id, Petri::VariableAccess::Read);
+}
@@ -31,8 +31,12 @@
 #define Petri_Types_hpp
 
 #include "../../Cpp/Action.h"
+#include "../../Cpp/Atomic.h"
 #include "../../Cpp/DebugServer.h"
+#include "../../Cpp/Executor.h"
 #include "../../Cpp/PetriNet.h"
+#include "../../Cpp/PetriNetBatch.h"
+#include "../../Cpp/PetriNetTemplate.h"
 #include "../../Cpp/Transition.h"
 #include <memory>
 
@@ -47,8 +51,24 @@ struct PetriNet {
     Petri::PetriNet *notOwned;
 };
 
+struct PetriVariable {
+    Petri::VariableHandle handle;
+};
+
 #endif
 
+struct PetriExecutor {
+    std::shared_ptr<Petri::Executor> executor;
+};
+
+struct PetriNetTemplate {
+    std::unique_ptr<Petri::PetriNetTemplate> petriNetTemplate;
+};
+
+struct PetriNetBatch {
+    std::unique_ptr<Petri::PetriNetBatch> batch;
+};
+
 struct PetriAction {
     std::unique_ptr<Petri::Action> owned;
     Petri::Action *notOwned;
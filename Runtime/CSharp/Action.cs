@@ -196,6 +196,11 @@ namespace Petri.Runtime
             Interop.Action.PetriAction_addVariable(Handle, id);
         }
 
+        public void AddReadVariable(UInt32 id)
+        {
+            Interop.Action.PetriAction_addReadVariable(Handle, id);
+        }
+
         List<Transition> _transitions = new List<Transition>();
     }
 }
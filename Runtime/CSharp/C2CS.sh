@@ -20,11 +20,16 @@ $(sed -n 's/[ 	]*\(.*(.*)\)[ 	]*;/\1;/p' <"$h" \
     | sed 's/volatile int64_t \*/IntPtr /g' \
     | sed 's/uint\([0-9]\{1,\}\)_t/UInt\1/g' \
     | sed 's/int\([0-9]\{1,\}\)_t/Int\1/g' \
+    | sed 's/\([^U]\)Int64 \*/\1out Int64 /g' \
     | sed 's/callable_t/ActionCallableDel/g' \
     | sed 's/parametrizedCallable_t/ParametrizedActionCallableDel/g' \
     | sed 's/transitionCallable_t/TransitionCallableDel/g' \
     | sed 's/parametrizedTransitionCallable_t/ParametrizedTransitionCallableDel/g' \
+    | sed 's/completionCallable_t/CompletionCallableDel/g' \
     | sed 's/Petri_actionResult_t/Int32/g' \
+    | sed 's/Petri_evaluationMode_t/EvaluationMode/g' \
+    | sed 's/Petri_executionMode_t/ExecutionMode/g' \
+    | sed 's/Petri_overflowPolicy_t/OverflowPolicy/g' \
     | sed 's/char const \*(\*\([^)]*\))()/StringCallableDel \1/g' \
     | sed 's/void \*(\*\([^)]*\))()/PtrCallableDel \1/g' \
     | sed 's/UInt16 (\*\([^)]*\))()/UInt16CallableDel \1/g' \
@@ -0,0 +1,71 @@
+﻿/*
+ * Copyright (c) 2016 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+using System;
+
+namespace Petri.Runtime
+{
+    /**
+     * A pool of worker threads which executes the actions of any count of PetriNet.
+     */
+    public class Executor : CInterop
+    {
+        /**
+         * Creates the executor. Workers are added on demand, up to maxWorkers, and the ones idle for longer than idleTimeout
+         * exit as long as there are more than minWorkers.
+         * @param name The name given to the worker threads
+         * @param minWorkers The count of workers kept alive
+         * @param maxWorkers The maximum count of workers, or 0 for no limit
+         * @param idleTimeout The delay after which an idle worker exits, in seconds
+         * @param overflowPolicy What to do with the task of an action when all of the workers are busy and none can be added
+         */
+        public Executor(string name,
+                        UInt64 minWorkers,
+                        UInt64 maxWorkers,
+                        double idleTimeout = 10,
+                        OverflowPolicy overflowPolicy = OverflowPolicy.Queue)
+        {
+            Handle = Interop.Executor.PetriExecutor_create(name,
+                                                           minWorkers,
+                                                           maxWorkers,
+                                                           (UInt64)(idleTimeout * 1.0e6),
+                                                           overflowPolicy);
+        }
+
+        /**
+         * Releases the executor, which is only destroyed once all of its nets have been.
+         */
+        protected override void Clean()
+        {
+            Interop.Executor.PetriExecutor_destroy(Handle);
+        }
+
+        /**
+         * The current count of worker threads.
+         */
+        public UInt64 ThreadCount {
+            get {
+                return Interop.Executor.PetriExecutor_threadCount(Handle);
+            }
+        }
+    }
+}
@@ -56,6 +56,9 @@ namespace Petri.Runtime.Interop {
 
         [DllImport("PetriRuntime")]
         public static extern void PetriAction_addVariable(IntPtr action, UInt32 id);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriAction_addReadVariable(IntPtr action, UInt32 id);
     }
 }
 
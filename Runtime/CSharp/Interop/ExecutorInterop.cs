@@ -0,0 +1,19 @@
+// This source file has been generated automatically from ../../C/Executor.h by C2CS.sh. Do not edit by hand.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Petri.Runtime.Interop {
+
+    public class Executor {
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriExecutor_create([MarshalAs(UnmanagedType.LPTStr)] string name, UInt64 minWorkers, UInt64 maxWorkers, UInt64 usIdleTimeout, OverflowPolicy overflowPolicy);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriExecutor_destroy(IntPtr executor);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriExecutor_threadCount(IntPtr executor);
+    }
+}
+
@@ -0,0 +1,40 @@
+// This source file has been generated automatically from ../../C/PetriNetBatch.h by C2CS.sh. Do not edit by hand.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Petri.Runtime.Interop {
+
+    public class PetriNetBatch {
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNetBatch_create(IntPtr petriNetTemplate, UInt64 instances);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNetBatch_destroy(IntPtr batch);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNetBatch_size(IntPtr batch);
+
+        [DllImport("PetriRuntime")]
+        public static extern Int64 PetriNetBatch_getValue(IntPtr batch, UInt32 id, UInt64 instance);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNetBatch_setValue(IntPtr batch, UInt32 id, UInt64 instance, Int64 value);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNetBatch_run(IntPtr batch);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNetBatch_step(IntPtr batch);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNetBatch_runUntilQuiescent(IntPtr batch);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNetBatch_activeInstances(IntPtr batch);
+
+        [DllImport("PetriRuntime")]
+        public static extern bool PetriNetBatch_completed(IntPtr batch, UInt64 instance);
+    }
+}
+
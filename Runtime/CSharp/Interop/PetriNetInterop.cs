@@ -9,6 +9,12 @@ namespace Petri.Runtime.Interop {
         [DllImport("PetriRuntime")]
         public static extern IntPtr PetriNet_create([MarshalAs(UnmanagedType.LPTStr)] string name);
 
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNet_createShared([MarshalAs(UnmanagedType.LPTStr)] string name);
+
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNet_createWithExecutor([MarshalAs(UnmanagedType.LPTStr)] string name, IntPtr executor);
+
         [DllImport("PetriRuntime")]
         public static extern IntPtr PetriNet_createDebug([MarshalAs(UnmanagedType.LPTStr)] string name);
 
@@ -30,6 +36,39 @@ namespace Petri.Runtime.Interop {
         [DllImport("PetriRuntime")]
         public static extern void PetriNet_join(IntPtr pn);
 
+        [DllImport("PetriRuntime")]
+        public static extern bool PetriNet_joinFor(IntPtr pn, UInt64 usTimeout);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNet_onCompletion(IntPtr pn, CompletionCallableDel callback);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNet_setEvaluationMode(IntPtr pn, EvaluationMode mode);
+
+        [DllImport("PetriRuntime")]
+        public static extern EvaluationMode PetriNet_getEvaluationMode(IntPtr pn);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNet_setExecutionMode(IntPtr pn, ExecutionMode mode);
+
+        [DllImport("PetriRuntime")]
+        public static extern ExecutionMode PetriNet_getExecutionMode(IntPtr pn);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNet_advance(IntPtr pn, UInt64 usduration);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNet_virtualTime(IntPtr pn);
+
+        [DllImport("PetriRuntime")]
+        public static extern bool PetriNet_step(IntPtr pn);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNet_stepCount(IntPtr pn, UInt64 count);
+
+        [DllImport("PetriRuntime")]
+        public static extern UInt64 PetriNet_runUntilQuiescent(IntPtr pn);
+
         [DllImport("PetriRuntime")]
         public static extern void PetriNet_addVariable(IntPtr pn, UInt32 id);
 
@@ -48,6 +87,24 @@ namespace Petri.Runtime.Interop {
         [DllImport("PetriRuntime")]
         public static extern void PetriNet_unlockVariable(IntPtr pn, UInt32 id);
 
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNet_getVariableHandle(IntPtr pn, UInt32 id);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriVariable_destroy(IntPtr variable);
+
+        [DllImport("PetriRuntime")]
+        public static extern Int64 PetriVariable_getValue(IntPtr variable);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriVariable_setValue(IntPtr variable, Int64 value);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNet_sendPayload(IntPtr pn, Int64 value);
+
+        [DllImport("PetriRuntime")]
+        public static extern bool PetriNet_takePayload(IntPtr pn, out Int64 value);
+
         [DllImport("PetriRuntime")]
         public static extern IntPtr PetriNet_getName(IntPtr pn);
     }
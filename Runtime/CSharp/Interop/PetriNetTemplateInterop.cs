@@ -0,0 +1,22 @@
+// This source file has been generated automatically from ../../C/PetriNetTemplate.h by C2CS.sh. Do not edit by hand.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Petri.Runtime.Interop {
+
+    public class PetriNetTemplate {
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNetTemplate_create(IntPtr prototype);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriNetTemplate_destroy(IntPtr petriNetTemplate);
+
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNetTemplate_instantiate(IntPtr petriNetTemplate);
+
+        [DllImport("PetriRuntime")]
+        public static extern IntPtr PetriNetTemplate_instantiateWithExecutor(IntPtr petriNetTemplate, IntPtr executor);
+    }
+}
+
@@ -44,6 +44,9 @@ namespace Petri.Runtime.Interop {
 
         [DllImport("PetriRuntime")]
         public static extern void PetriTransition_addVariable(IntPtr transition, UInt32 id);
+
+        [DllImport("PetriRuntime")]
+        public static extern void PetriTransition_addReadVariable(IntPtr transition, UInt32 id);
     }
 }
 
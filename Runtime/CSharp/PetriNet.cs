@@ -51,6 +51,26 @@ namespace Petri.Runtime
             Handle = Interop.PetriNet.PetriNet_create(name);
         }
 
+        /**
+         * Creates the PetriNet, assigning it a name which serves debug purposes.
+         * @param name the name to assign to the PetriNet or a designated one if left empty
+         * @param sharedExecutor whether the actions of the net are executed by the worker threads shared by the nets of the process, or by its own ones
+         */
+        public PetriNet(string name, bool sharedExecutor) : this()
+        {
+            Handle = sharedExecutor ? Interop.PetriNet.PetriNet_createShared(name) : Interop.PetriNet.PetriNet_create(name);
+        }
+
+        /**
+         * Creates the PetriNet, whose actions are executed by the worker threads of an executor, which may be shared with other nets.
+         * @param name the name to assign to the PetriNet or a designated one if left empty
+         * @param executor the executor of the net, whose overflow policy applies to the net
+         */
+        public PetriNet(string name, Executor executor) : this()
+        {
+            Handle = Interop.PetriNet.PetriNet_createWithExecutor(name, executor.Handle);
+        }
+
         protected override void Clean()
         {
             Interop.PetriNet.PetriNet_destroy(Handle);
@@ -103,6 +123,105 @@ namespace Petri.Runtime
             Interop.PetriNet.PetriNet_join(Handle);
         }
 
+        /**
+         * Blocks the calling thread until the Petri net has completed its whole execution, or until the timeout expires.
+         * @param timeout The maximum duration to wait for
+         * @return true if the net has completed its execution, false if the timeout expired
+         */
+        public bool JoinFor(TimeSpan timeout)
+        {
+            return Interop.PetriNet.PetriNet_joinFor(Handle, (UInt64)Math.Max(0, timeout.Ticks / 10));
+        }
+
+        /**
+         * Registers a callback invoked once the Petri net has completed its whole execution, on the thread that stopped it.
+         * If the net is not running, the callback is invoked immediately. The callback must neither destroy nor stop the net.
+         * @param callback The callback to invoke
+         */
+        public void OnCompletion(CompletionCallableDel callback)
+        {
+            // The delegate must outlive the native petri net.
+            var c = new CompletionCallableDel(callback);
+            _completionCallbacks.Add(c);
+            Interop.PetriNet.PetriNet_onCompletion(Handle, c);
+        }
+
+        /**
+         * The way the transitions of the active states are evaluated again after a failed evaluation.
+         * The net must not be running when this is changed.
+         */
+        public EvaluationMode EvaluationMode {
+            get {
+                return Interop.PetriNet.PetriNet_getEvaluationMode(Handle);
+            }
+            set {
+                Interop.PetriNet.PetriNet_setEvaluationMode(Handle, value);
+            }
+        }
+
+        /**
+         * Which threads execute the states of the net. In the Deterministic and Simulated modes, the states are executed one
+         * at a time and in a reproducible order by the thread stepping the net, the Simulated mode advancing a virtual clock
+         * with the pauses of the actions and the delays between the evaluations of the transitions instead of blocking the
+         * thread. The net must not be running when this is changed.
+         */
+        public ExecutionMode ExecutionMode {
+            get {
+                return Interop.PetriNet.PetriNet_getExecutionMode(Handle);
+            }
+            set {
+                Interop.PetriNet.PetriNet_setExecutionMode(Handle, value);
+            }
+        }
+
+        /**
+         * The virtual time elapsed since a simulated net was started, in seconds.
+         */
+        public double VirtualTime {
+            get {
+                return Interop.PetriNet.PetriNet_virtualTime(Handle) / 1.0e6;
+            }
+        }
+
+        /**
+         * Performs the steps of a simulated net which are due before its virtual clock has advanced by the specified duration,
+         * and then sets the clock to the end of that duration.
+         * @param duration The duration to simulate, in seconds
+         * @return The count of steps performed
+         */
+        public UInt64 Advance(double duration)
+        {
+            return Interop.PetriNet.PetriNet_advance(Handle, (UInt64)(duration * 1.0e6));
+        }
+
+        /**
+         * Performs a single step of a net running in the deterministic mode, on the calling thread.
+         * @return false if the net is not running or nothing could be done, true otherwise
+         */
+        public bool Step()
+        {
+            return Interop.PetriNet.PetriNet_step(Handle);
+        }
+
+        /**
+         * Performs at most count steps of a net running in the deterministic mode.
+         * @param count The maximum count of steps
+         * @return The count of steps performed
+         */
+        public UInt64 Step(UInt64 count)
+        {
+            return Interop.PetriNet.PetriNet_stepCount(Handle, count);
+        }
+
+        /**
+         * Steps a net running in the deterministic mode until it either completes, or waits for transitions which are not fulfilled.
+         * @return The count of steps performed
+         */
+        public UInt64 RunUntilQuiescent()
+        {
+            return Interop.PetriNet.PetriNet_runUntilQuiescent(Handle);
+        }
+
         /**
          * Adds an Atomic variable designated by the specified id.
          * @param id the id of the new Atomic variable
@@ -121,6 +240,37 @@ namespace Petri.Runtime
             return new Atomic(this, id);
         }
 
+        /**
+         * Gets a handle to an atomic variable previously added to the Petri net, which is resolved once instead of on
+         * each access. Trying to retrieve a non existing variable will throw an exception.
+         * @param the id of the Atomic to retrieve.
+         */
+        public VariableHandle GetVariableHandle(UInt32 id)
+        {
+            return new VariableHandle(this, id);
+        }
+
+        /**
+         * Attaches a payload holding an integer to the token sent by the action executed by the calling thread, replacing
+         * the previous one if any. Must only be called by an action of the net.
+         * @param value The value carried by the token
+         */
+        public void SendPayload(Int64 value)
+        {
+            Interop.PetriNet.PetriNet_sendPayload(Handle, value);
+        }
+
+        /**
+         * Takes the next payload of the tokens which activated the action executed by the calling thread. Must only be
+         * called by an action of the net.
+         * @param value Receives the value carried by the token
+         * @return false if no payload is left, or if the payload taken does not hold an integer
+         */
+        public bool TakePayload(out Int64 value)
+        {
+            return Interop.PetriNet.PetriNet_takePayload(Handle, out value);
+        }
+
         public string Name {
             get {
                 return System.Runtime.InteropServices.Marshal.PtrToStringAuto(Interop.PetriNet.PetriNet_getName(Handle));
@@ -128,6 +278,7 @@ namespace Petri.Runtime
         }
 
         List<Action> _actions = new List<Action>();
+        List<CompletionCallableDel> _completionCallbacks = new List<CompletionCallableDel>();
     }
 }
 
@@ -0,0 +1,127 @@
+﻿/*
+ * Copyright (c) 2016 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+using System;
+
+namespace Petri.Runtime
+{
+    /**
+     * Executes any count of independent instances of the net of a PetriNetTemplate on the calling thread, as in the
+     * Deterministic execution mode. The variables of the instances hold the values of the variables of the prototype,
+     * and the pauses of the actions are ignored.
+     */
+    public class PetriNetBatch : CInterop
+    {
+        /**
+         * Creates a batch of instances of a template.
+         * @param petriNetTemplate The template of the instances
+         * @param instances The count of instances
+         */
+        public PetriNetBatch(PetriNetTemplate petriNetTemplate, UInt64 instances)
+        {
+            Handle = Interop.PetriNetBatch.PetriNetBatch_create(petriNetTemplate.Handle, instances);
+            if(Handle == IntPtr.Zero) {
+                throw new Exception("The batch could not be created from the template!");
+            }
+        }
+
+        protected override void Clean()
+        {
+            Interop.PetriNetBatch.PetriNetBatch_destroy(Handle);
+        }
+
+        /**
+         * The count of instances of the batch.
+         */
+        public UInt64 Size {
+            get {
+                return Interop.PetriNetBatch.PetriNetBatch_size(Handle);
+            }
+        }
+
+        /**
+         * Gets the value of a variable in an instance of the batch.
+         * @param id The ID of the variable
+         * @param instance The index of the instance
+         */
+        public Int64 GetValue(UInt32 id, UInt64 instance)
+        {
+            return Interop.PetriNetBatch.PetriNetBatch_getValue(Handle, id, instance);
+        }
+
+        /**
+         * Sets the value of a variable in an instance of the batch, before it is run or between two steps.
+         * @param id The ID of the variable
+         * @param instance The index of the instance
+         * @param value The new value of the variable
+         */
+        public void SetValue(UInt32 id, UInt64 instance, Int64 value)
+        {
+            Interop.PetriNetBatch.PetriNetBatch_setValue(Handle, id, instance, value);
+        }
+
+        /**
+         * Starts every instance of the batch from the initial states of the net, which is done again if the batch has
+         * already been run. The variables are left as they are.
+         */
+        public void Run()
+        {
+            Interop.PetriNetBatch.PetriNetBatch_run(Handle);
+        }
+
+        /**
+         * Performs a sweep across the instances of the batch.
+         * @return The count of actions executed and transitions crossed, which is 0 once no instance can progress anymore
+         */
+        public UInt64 Step()
+        {
+            return Interop.PetriNetBatch.PetriNetBatch_step(Handle);
+        }
+
+        /**
+         * Performs sweeps until no instance of the batch can progress anymore.
+         * @return The count of sweeps performed
+         */
+        public UInt64 RunUntilQuiescent()
+        {
+            return Interop.PetriNetBatch.PetriNetBatch_runUntilQuiescent(Handle);
+        }
+
+        /**
+         * The count of instances which have not completed yet.
+         */
+        public UInt64 ActiveInstances {
+            get {
+                return Interop.PetriNetBatch.PetriNetBatch_activeInstances(Handle);
+            }
+        }
+
+        /**
+         * Checks whether an instance has completed, i.e. has no active state left.
+         * @param instance The index of the instance
+         */
+        public bool Completed(UInt64 instance)
+        {
+            return Interop.PetriNetBatch.PetriNetBatch_completed(Handle, instance);
+        }
+    }
+}
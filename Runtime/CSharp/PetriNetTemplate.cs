@@ -0,0 +1,70 @@
+﻿/*
+ * Copyright (c) 2016 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+using System;
+
+namespace Petri.Runtime
+{
+    /**
+     * The immutable structure of a PetriNet, from which any count of nets can be instantiated. The instances share the
+     * states and transitions of the template, whose callables are invoked concurrently by the instances.
+     */
+    public class PetriNetTemplate : CInterop
+    {
+        /**
+         * Creates a template from a net, filled with its states, transitions and variables.
+         * @param prototype The net, which must not be running. It becomes the prototype of the instances, and cannot be
+         * used anymore.
+         */
+        public PetriNetTemplate(PetriNet prototype)
+        {
+            Handle = Interop.PetriNetTemplate.PetriNetTemplate_create(prototype.Release());
+            if(Handle == IntPtr.Zero) {
+                throw new Exception("The petri net could not become a template!");
+            }
+        }
+
+        protected override void Clean()
+        {
+            Interop.PetriNetTemplate.PetriNetTemplate_destroy(Handle);
+        }
+
+        /**
+         * Creates a net executing the states and transitions of the template. Its variables are created with the values
+         * of the ones of the prototype, and its actions are executed by the executor of the prototype.
+         */
+        public PetriNet Instantiate()
+        {
+            return new PetriNet(Interop.PetriNetTemplate.PetriNetTemplate_instantiate(Handle));
+        }
+
+        /**
+         * Creates a net executing the states and transitions of the template, whose actions are executed by the
+         * specified executor.
+         * @param executor The executor of the net
+         */
+        public PetriNet Instantiate(Executor executor)
+        {
+            return new PetriNet(Interop.PetriNetTemplate.PetriNetTemplate_instantiateWithExecutor(Handle, executor.Handle));
+        }
+    }
+}
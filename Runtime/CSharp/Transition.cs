@@ -128,6 +128,10 @@ namespace Petri.Runtime
         public void AddVariable(UInt32 id) {
             Interop.Transition.PetriTransition_addVariable(Handle, id);
         }
+
+        public void AddReadVariable(UInt32 id) {
+            Interop.Transition.PetriTransition_addReadVariable(Handle, id);
+        }
     }
 }
 
@@ -35,6 +35,44 @@ namespace Petri.Runtime
     public delegate Int32 ParametrizedActionCallableDel(IntPtr petriNet);
     public delegate bool TransitionCallableDel(Int32 result);
     public delegate bool ParametrizedTransitionCallableDel(IntPtr petriNet, Int32 result);
+    public delegate void CompletionCallableDel(IntPtr petriNet);
+
+    /**
+     * The way the transitions of the active states of a PetriNet are evaluated again after a failed evaluation.
+     */
+    public enum EvaluationMode
+    {
+        // Every transition is periodically evaluated, according to its delay between evaluations.
+        Polling,
+        // The transitions which depend on variables are only evaluated again when one of these variables changes.
+        VariableChange
+    }
+
+    /**
+     * Which threads execute the states of a PetriNet.
+     */
+    public enum ExecutionMode
+    {
+        // The states are executed concurrently by the worker threads of the net.
+        Concurrent,
+        // The states are executed one at a time and in a reproducible order, by the thread stepping the net.
+        Deterministic,
+        // The states are executed as in the Deterministic mode, against a virtual clock.
+        Simulated
+    }
+
+    /**
+     * What happens to the task of an action when all of the worker threads of an Executor are busy and none can be added.
+     */
+    public enum OverflowPolicy
+    {
+        // The task waits for a worker to be available.
+        Queue,
+        // The task is dropped.
+        Reject,
+        // The task is executed by the thread adding it.
+        Inline
+    }
 
     public class WrapForNative
     {
@@ -0,0 +1,63 @@
+﻿/*
+ * Copyright (c) 2016 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+using System;
+
+using System;
+
+namespace Petri.Runtime
+{
+    /**
+     * An Atomic variable of a PetriNet, resolved once so that it is not looked up again on each access.
+     */
+    public class VariableHandle : CInterop
+    {
+        internal VariableHandle(PetriNet pn, UInt32 id)
+        {
+            // The net is kept alive as long as the handle, which designates one of its variables.
+            _pn = pn;
+            Handle = Interop.PetriNet.PetriNet_getVariableHandle(pn.Handle, id);
+        }
+
+        /**
+         * Releases the handle. The variable itself is left untouched.
+         */
+        protected override void Clean()
+        {
+            Interop.PetriNet.PetriVariable_destroy(Handle);
+        }
+
+        /**
+         * The value of the variable. The transitions waiting on the variable are notified when it is set.
+         */
+        public Int64 Value {
+            get {
+                return Interop.PetriNet.PetriVariable_getValue(Handle);
+            }
+            set {
+                Interop.PetriNet.PetriVariable_setValue(Handle, value);
+            }
+        }
+
+        PetriNet _pn;
+    }
+}
@@ -31,9 +31,11 @@
 #define Petri_Action_h
 
 #include "Callable.h"
+#include "MonotonicArena.h"
+#include "PetriNet.h"
 #include "Transition.h"
+#include <atomic>
 #include <list>
-#include <mutex>
 
 namespace Petri {
 
@@ -87,7 +89,17 @@ namespace Petri {
          * to execute.
          */
         Action(uint64_t id, std::string const &name, ParametrizedActionCallableBase const &action, size_t requiredTokens);
-        Action(uint64_t id, std::string const &name, actionResult_t (*action)(PetriNet &), size_t requiredTokens);
+
+        /**
+         * Creates an empty action, associated to the specified Function, which is moved into the
+         * action. Plain function pointers are invoked without any indirection.
+         * @param id The ID of the new action.
+         * @param name The name of the new action.
+         * @param action The Function which will be called when the action is run.
+         * @param requiredTokens The number of tokens that must be inside the active action for it
+         * to execute.
+         */
+        Action(uint64_t id, std::string const &name, ActionFunction action, size_t requiredTokens);
 
         Action(Action &&) noexcept;
         Action(Action const &) = delete;
@@ -109,8 +121,26 @@ namespace Petri {
         Transition &
         addTransition(uint64_t id, std::string const &name, Action &next, TransitionCallableBase const &cond);
         Transition &addTransition(uint64_t id, std::string const &name, Action &next, bool (*cond)(actionResult_t));
-        Transition &
-        addTransition(uint64_t id, std::string const &name, Action &next, bool (*cond)(PetriNet &, actionResult_t));
+
+        /**
+         * Adds a Transition to the Action.
+         * @param id the id of the Transition
+         * @param name the name of the transition to be added
+         * @param next the Action following the transition to be added
+         * @param cond the condition of the Transition to be added, which is moved into it
+         * @return The newly created transition.
+         */
+        Transition &addTransition(uint64_t id, std::string const &name, Action &next, TransitionFunction cond);
+
+        /**
+         * Adds a Transition to the Action, which refers to its name instead of copying it.
+         * @param id the id of the Transition
+         * @param name the name of the transition to be added, which must outlive it
+         * @param next the Action following the transition to be added
+         * @param cond the condition of the Transition to be added, which is moved into it
+         * @return The newly created transition.
+         */
+        Transition &addTransition(uint64_t id, InternedName name, Action &next, TransitionFunction cond);
 
         /**
          * Adds a Transition to the Action.
@@ -124,7 +154,7 @@ namespace Petri {
          * invoke this method!
          * @return The Callable of the Action
          */
-        ParametrizedActionCallableBase &action() noexcept;
+        ActionFunction &action() noexcept;
 
         /**
          * Changes the Callable associated to the Action
@@ -138,7 +168,12 @@ namespace Petri {
          * @param action The Callable which will be copied and put in the Action
          */
         void setAction(ParametrizedActionCallableBase const &action);
-        void setAction(actionResult_t (*action)(PetriNet &));
+
+        /**
+         * Changes the Function associated to the Action
+         * @param action The Function which will be moved into the Action
+         */
+        void setAction(ActionFunction action);
 
         /**
          * Returns the required tokens of the Action to be activated, i.e. the count of Actions
@@ -159,6 +194,13 @@ namespace Petri {
          */
         std::size_t currentTokens() noexcept;
 
+        /**
+         * Gets the count of active instances of the Action, i.e. the tokens which have activated it
+         * and are executing it or waiting for one of its transitions to be fulfilled.
+         * @return The active instances count of the Action
+         */
+        std::size_t activeCount() const noexcept;
+
         /**
          * Returns the name of the Action.
          * @return The name of the Action
@@ -171,19 +213,36 @@ namespace Petri {
          */
         void setName(std::string const &name) noexcept(std::is_nothrow_move_constructible<std::string>::value);
 
+        using TransitionList = std::list<Transition, ArenaAllocator<Transition>>;
+
         /**
          * Returns the transitions exiting the Action.
          */
-        std::list<Transition> const &transitions() const noexcept;
+        TransitionList const &transitions() const noexcept;
 
     private:
-        std::size_t &currentTokensRef() noexcept;
-        std::mutex &tokensMutex() noexcept;
+        // The tokens and the active instances of an Action. The PetriNet running the Action moves
+        // them to a contiguous array, shared with the other Actions of the net.
+        struct Counters {
+            std::atomic<std::size_t> _tokens = {0};
+            std::atomic<std::size_t> _active = {0};
+        };
+
+        Counters &counters() noexcept;
+        /**
+         * Makes the Action use the specified counters, after having copied its current counts to them.
+         * @param counters The new counters of the Action, which must outlive it or be replaced
+         */
+        void setCounters(Counters &counters) noexcept;
+
+        // Creates an action whose storage, and the one of its transitions, comes from an arena.
+        Action(MonotonicArena &arena, uint64_t id, std::string const &name, ActionFunction action, size_t requiredTokens);
+        Action(MonotonicArena &arena, uint64_t id, InternedName name, ActionFunction action, size_t requiredTokens);
 
         Transition &addTransition(Transition t);
 
         struct Internals;
-        std::unique_ptr<Internals> _internals;
+        ArenaPtr<Internals> _internals;
     };
 }
 
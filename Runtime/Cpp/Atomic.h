@@ -31,12 +31,104 @@
 #define Petri_Atomic_h
 
 #include "PetriUtils.h"
+#include <algorithm>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 namespace Petri {
 
     class Atomic {
     public:
+        /**
+         * An object which is notified when the value of the Atomic variables it subscribed to may
+         * have changed.
+         */
+        struct Observer {
+            virtual ~Observer() = default;
+            virtual void variableChanged(Atomic &variable) = 0;
+        };
+
+        /**
+         * Accesses the value of an Atomic variable without any lock. Each operator is a single
+         * atomic operation, so an expression using the value more than once is not atomic as a
+         * whole.
+         */
+        class LockFreeValue {
+        public:
+            explicit LockFreeValue(Atomic &variable) noexcept
+                    : _variable(variable) {}
+
+            LockFreeValue &operator=(LockFreeValue const &) = delete;
+
+            operator std::int64_t() const noexcept {
+                return this->load();
+            }
+
+            std::int64_t operator=(std::int64_t value) noexcept {
+                this->store(value);
+                return value;
+            }
+
+            std::int64_t operator++() noexcept {
+                return this->fetchAdd(1) + 1;
+            }
+
+            std::int64_t operator--() noexcept {
+                return this->fetchAdd(-1) - 1;
+            }
+
+            std::int64_t operator++(int) noexcept {
+                return this->fetchAdd(1);
+            }
+
+            std::int64_t operator--(int) noexcept {
+                return this->fetchAdd(-1);
+            }
+
+        private:
+            // GCC and Clang operate atomically on the plain storage of the variable. Other compilers
+            // serialize the operations with a mutex of their own, as the variable itself may already
+            // be locked by the runtime when it is also accessed by a non atomic entity.
+            std::int64_t load() const noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return __atomic_load_n(&_variable._value, __ATOMIC_SEQ_CST);
+#else
+                std::lock_guard<std::mutex> lk(operationsMutex());
+                return _variable._value;
+#endif
+            }
+
+            void store(std::int64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                __atomic_store_n(&_variable._value, value, __ATOMIC_SEQ_CST);
+#else
+                std::lock_guard<std::mutex> lk(operationsMutex());
+                _variable._value = value;
+#endif
+            }
+
+            std::int64_t fetchAdd(std::int64_t delta) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return __atomic_fetch_add(&_variable._value, delta, __ATOMIC_SEQ_CST);
+#else
+                std::lock_guard<std::mutex> lk(operationsMutex());
+                auto previous = _variable._value;
+                _variable._value += delta;
+                return previous;
+#endif
+            }
+
+#if !defined(__GNUC__) && !defined(__clang__)
+            static std::mutex &operationsMutex() noexcept {
+                static std::mutex mutex;
+                return mutex;
+            }
+#endif
+
+            Atomic &_variable;
+        };
+
         Atomic()
                 : _value(0) {}
 
@@ -44,18 +136,102 @@ namespace Petri {
             return _value;
         }
 
+        /**
+         * Returns the value of the variable, to be read or modified with a single atomic operation.
+         * The runtime does not lock the variables which are only accessed this way, so a variable
+         * modified from outside of the Petri net while it runs should be modified through this too.
+         */
+        LockFreeValue lockFreeValue() noexcept {
+            return LockFreeValue{*this};
+        }
+
         auto getLock() noexcept(
-        std::is_nothrow_constructible<std::unique_lock<std::mutex>, std::mutex &, std::defer_lock_t>::value) {
-            return std::unique_lock<std::mutex>{_mutex, std::defer_lock};
+        std::is_nothrow_constructible<std::unique_lock<std::shared_timed_mutex>, std::shared_timed_mutex &, std::defer_lock_t>::value) {
+            return std::unique_lock<std::shared_timed_mutex>{_mutex, std::defer_lock};
+        }
+
+        /**
+         * Returns a deferred lock sharing the variable with the other readers, which is enough to
+         * read its value. Writers still need the exclusive lock returned by getLock().
+         */
+        auto getSharedLock() noexcept(
+        std::is_nothrow_constructible<std::shared_lock<std::shared_timed_mutex>, std::shared_timed_mutex &, std::defer_lock_t>::value) {
+            return std::shared_lock<std::shared_timed_mutex>{_mutex, std::defer_lock};
         }
 
         auto &getMutex() noexcept {
             return _mutex;
         }
 
+        /**
+         * Subscribes an observer to the changes of the variable. The observer must unsubscribe
+         * before being destroyed.
+         * @param observer The observer to notify
+         */
+        void subscribe(Observer &observer) {
+            std::lock_guard<std::mutex> lk(_observersMutex);
+            _observers.push_back(&observer);
+        }
+
+        /**
+         * Unsubscribes an observer previously subscribed to the changes of the variable. Once this
+         * method returns, the observer will not be notified anymore.
+         * @param observer The observer to remove
+         */
+        void unsubscribe(Observer &observer) {
+            std::lock_guard<std::mutex> lk(_observersMutex);
+            _observers.erase(std::remove(_observers.begin(), _observers.end(), &observer), _observers.end());
+        }
+
+        /**
+         * Notifies the subscribed observers that the value of the variable may have changed. The
+         * runtime does it after the execution of every Action which may modify the variable, so this
+         * only has to be called after a modification made from outside of the Petri net.
+         */
+        void notifyChange() {
+            std::lock_guard<std::mutex> lk(_observersMutex);
+            for(auto observer : _observers) {
+                observer->variableChanged(*this);
+            }
+        }
+
+    private:
+        // Aligned for the atomic operations of LockFreeValue, even on 32 bit platforms
+        alignas(8) std::int64_t _value;
+        std::shared_timed_mutex _mutex;
+
+        std::mutex _observersMutex;
+        std::vector<Observer *> _observers;
+    };
+
+    /**
+     * Designates an Atomic variable of a PetriNet, resolved once from its ID so that accessing the
+     * variable does not look it up again. A handle remains valid as long as its PetriNet.
+     */
+    class VariableHandle {
+    public:
+        VariableHandle() = default;
+        explicit VariableHandle(Atomic &variable) noexcept
+                : _variable(&variable) {}
+
+        Atomic &operator*() const noexcept {
+            return *_variable;
+        }
+
+        Atomic *operator->() const noexcept {
+            return _variable;
+        }
+
+        auto &value() const noexcept {
+            return _variable->value();
+        }
+
+        explicit operator bool() const noexcept {
+            return _variable != nullptr;
+        }
+
     private:
-        std::int64_t _value;
-        std::mutex _mutex;
+        Atomic *_variable = nullptr;
     };
 }
 
@@ -8,9 +8,12 @@
 #ifndef Petri_Callable_h
 #define Petri_Callable_h
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 template <typename ReturnType, typename... Args>
 struct CallableBase {
@@ -39,4 +42,154 @@ private:
     std::remove_reference_t<CallableType> _c;
 };
 
+namespace Petri {
+    template <typename Signature>
+    class Function;
+
+    /**
+     * A move-only type-erased callable. The callables small enough are stored inline, and the plain
+     * function pointers (as well as the lambdas without capture) are called directly, without any
+     * indirection.
+     */
+    template <typename ReturnType, typename... Args>
+    class Function<ReturnType(Args...)> {
+        using Pointer = ReturnType (*)(Args...);
+
+        template <typename Stored, typename = void>
+        struct IsCompatible : std::false_type {};
+        template <typename Stored>
+        struct IsCompatible<Stored,
+                            std::enable_if_t<!std::is_same<Stored, Function>::value &&
+                                             (std::is_void<ReturnType>::value ||
+                                              std::is_convertible<std::result_of_t<Stored &(Args...)>, ReturnType>::value)>>
+                : std::true_type {};
+
+    public:
+        static constexpr std::size_t BufferSize = 3 * sizeof(void *);
+
+        Function() noexcept = default;
+        Function(std::nullptr_t) noexcept {}
+        Function(Pointer function) noexcept
+                : _function(function) {}
+
+        template <typename CallableType, typename = std::enable_if_t<IsCompatible<std::decay_t<CallableType>>::value>>
+        Function(CallableType &&callable) {
+            using Stored = std::decay_t<CallableType>;
+            this->store<Stored>(std::forward<CallableType>(callable), StorageOf<Stored>());
+        }
+
+        Function(Function &&other) noexcept {
+            this->moveFrom(other);
+        }
+
+        Function &operator=(Function &&other) noexcept {
+            if(this != &other) {
+                this->reset();
+                this->moveFrom(other);
+            }
+            return *this;
+        }
+
+        Function(Function const &) = delete;
+        Function &operator=(Function const &) = delete;
+
+        ~Function() {
+            this->reset();
+        }
+
+        explicit operator bool() const noexcept {
+            return _function != nullptr || _invoke != nullptr;
+        }
+
+        /**
+         * Invokes the callable. Must not be called on an empty Function.
+         */
+        ReturnType operator()(Args... args) const {
+            if(_function != nullptr) {
+                return _function(std::forward<Args>(args)...);
+            }
+            return _invoke(_buffer, std::forward<Args>(args)...);
+        }
+
+    private:
+        using Buffer = std::aligned_storage_t<BufferSize, alignof(void *)>;
+        enum class Operation { Move, Destroy };
+
+        enum class Storage { Pointer, Inline, Heap };
+        template <typename Stored>
+        using StorageOf = std::integral_constant<
+        Storage,
+        std::is_convertible<Stored, Pointer>::value ?
+        Storage::Pointer :
+        (sizeof(Stored) <= sizeof(Buffer) && alignof(Buffer) % alignof(Stored) == 0 &&
+         std::is_nothrow_move_constructible<Stored>::value) ?
+        Storage::Inline :
+        Storage::Heap>;
+
+        template <typename Stored, typename CallableType>
+        void store(CallableType &&callable, std::integral_constant<Storage, Storage::Pointer>) {
+            _function = static_cast<Pointer>(callable);
+        }
+
+        template <typename Stored, typename CallableType>
+        void store(CallableType &&callable, std::integral_constant<Storage, Storage::Inline>) {
+            new(&_buffer) Stored(std::forward<CallableType>(callable));
+            _invoke = [](Buffer &buffer, Args... args) -> ReturnType {
+                return (*reinterpret_cast<Stored *>(&buffer))(std::forward<Args>(args)...);
+            };
+            _manage = [](Operation operation, Buffer &buffer, Buffer *destination) {
+                auto &stored = *reinterpret_cast<Stored *>(&buffer);
+                if(operation == Operation::Move) {
+                    new(destination) Stored(std::move(stored));
+                }
+                stored.~Stored();
+            };
+        }
+
+        template <typename Stored, typename CallableType>
+        void store(CallableType &&callable, std::integral_constant<Storage, Storage::Heap>) {
+            new(&_buffer) Stored *(new Stored(std::forward<CallableType>(callable)));
+            _invoke = [](Buffer &buffer, Args... args) -> ReturnType {
+                return (**reinterpret_cast<Stored **>(&buffer))(std::forward<Args>(args)...);
+            };
+            _manage = [](Operation operation, Buffer &buffer, Buffer *destination) {
+                auto stored = *reinterpret_cast<Stored **>(&buffer);
+                if(operation == Operation::Move) {
+                    new(destination) Stored *(stored);
+                } else {
+                    delete stored;
+                }
+            };
+        }
+
+        void moveFrom(Function &other) noexcept {
+            _function = other._function;
+            _invoke = other._invoke;
+            _manage = other._manage;
+            if(_manage != nullptr) {
+                _manage(Operation::Move, other._buffer, &_buffer);
+            }
+
+            other._function = nullptr;
+            other._invoke = nullptr;
+            other._manage = nullptr;
+        }
+
+        void reset() noexcept {
+            if(_manage != nullptr) {
+                _manage(Operation::Destroy, _buffer, nullptr);
+            }
+
+            _function = nullptr;
+            _invoke = nullptr;
+            _manage = nullptr;
+        }
+
+        Pointer _function = nullptr;
+        ReturnType (*_invoke)(Buffer &, Args...) = nullptr;
+        void (*_manage)(Operation, Buffer &, Buffer *) = nullptr;
+        mutable Buffer _buffer;
+    };
+}
+
 #endif
@@ -31,7 +31,10 @@
 #define Petri_Common_h
 
 #include "../C/Types.h"
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <limits>
 #include <list>
 #include <string>
 
@@ -42,6 +45,73 @@ namespace Petri {
 
     using actionResult_t = Petri_actionResult_t;
 
+    /**
+     * Controls the worker threads of a thread pool, such as the one executing the actions of a
+     * PetriNet. Workers are added on demand, up to maxWorkers, and the ones idle for longer than
+     * idleTimeout exit as long as there are more than minWorkers.
+     */
+    struct WorkerOptions {
+        /**
+         * What happens to a task when all of the workers are busy and none can be added.
+         */
+        enum class OverflowPolicy {
+            // The task waits for a worker to be available.
+            Queue,
+            // The task is dropped.
+            Reject,
+            // The task is executed by the thread adding it.
+            Inline,
+        };
+
+        std::size_t minWorkers = 1;
+        std::size_t maxWorkers = std::numeric_limits<std::size_t>::max();
+        // The stack size of the workers, or 0 for the default of the platform.
+        std::size_t stackSize = 0;
+        std::chrono::nanoseconds idleTimeout = std::chrono::seconds(10);
+        OverflowPolicy overflowPolicy = OverflowPolicy::Queue;
+    };
+
+    /**
+     * How an Entity accesses one of its variables. The variables which are only read can be read
+     * concurrently by several entities.
+     */
+    enum class VariableAccess {
+        Read,
+        ReadWrite,
+        // The entity performs a single operation on the variable through Atomic::lockFreeValue(),
+        // which needs no lock as long as the other entities accessing the variable do the same.
+        AtomicRead,
+        AtomicReadWrite,
+    };
+
+    /**
+     * Designates a string which outlives the entities named after it, such as an entry of the name
+     * table emitted by the code generator. The entities refer to the string instead of copying it.
+     */
+    class InternedName {
+    public:
+        /**
+         * Designates the empty name, which is given to the entities of the nets stripped of their names.
+         */
+        InternedName() noexcept
+                : _name(&empty()) {}
+
+        explicit InternedName(std::string const &name) noexcept
+                : _name(&name) {}
+
+        std::string const &get() const noexcept {
+            return *_name;
+        }
+
+    private:
+        static std::string const &empty() noexcept {
+            static std::string const name;
+            return name;
+        }
+
+        std::string const *_name;
+    };
+
     struct Entity {
     public:
         Entity(uint64_t id)
@@ -58,9 +128,34 @@ namespace Petri {
         /**
          * Adds a variable to the entity's associated ones.
          * @param id The new variable to add.
+         * @param access Whether the entity only reads the variable, or may also modify it.
          */
-        void addVariable(std::uint_fast32_t id) {
+        void addVariable(std::uint_fast32_t id, VariableAccess access = VariableAccess::ReadWrite) {
             _vars.push_back(id);
+            if(access == VariableAccess::ReadWrite || access == VariableAccess::AtomicReadWrite) {
+                _writtenVars.push_back(id);
+            }
+            if(access == VariableAccess::Read || access == VariableAccess::ReadWrite) {
+                _lockedVars.push_back(id);
+            }
+        }
+
+        /**
+         * Returns whether the entity may modify a variable, i.e. whether the variable was added at
+         * least once with the VariableAccess::ReadWrite or VariableAccess::AtomicReadWrite access.
+         * @param id The ID of the variable
+         */
+        bool writesVariable(std::uint_fast32_t id) const {
+            return std::find(_writtenVars.begin(), _writtenVars.end(), id) != _writtenVars.end();
+        }
+
+        /**
+         * Returns whether the entity needs the variable to be locked while it accesses it, i.e.
+         * whether the variable was added at least once with a non atomic access.
+         * @param id The ID of the variable
+         */
+        bool locksVariable(std::uint_fast32_t id) const {
+            return std::find(_lockedVars.begin(), _lockedVars.end(), id) != _lockedVars.end();
         }
 
         /**
@@ -74,6 +169,8 @@ namespace Petri {
     private:
         std::uint64_t _id;
         std::list<std::uint_fast32_t> _vars;
+        std::list<std::uint_fast32_t> _writtenVars;
+        std::list<std::uint_fast32_t> _lockedVars;
     };
 }
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  Executor.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_Executor_h
+#define Petri_Executor_h
+
+#include "Common.h"
+#include <memory>
+#include <string>
+
+namespace Petri {
+
+    class ExecutorQueue;
+
+    /**
+     * A pool of worker threads which executes the actions of any count of PetriNet. Each net queues
+     * its tasks on its own, and the workers serve the nets with queued tasks in turn, one task at a
+     * time, so that a busy net does not starve the other ones. A net keeps pausing and stopping on
+     * its own, without affecting the other nets of the executor.
+     * A net created without an executor gets its own.
+     */
+    class Executor {
+        friend class ExecutorQueue;
+
+    public:
+        /**
+         * Creates the executor.
+         * @param options Controls the count, stack size and lifetime of the worker threads. Its
+         * overflow policy applies to the nets of the executor.
+         * @param name This string is used for debug purposes: it gives a name to each worker thread
+         */
+        explicit Executor(WorkerOptions const &options = WorkerOptions(), std::string const &name = "Petri executor");
+
+        /**
+         * Stops the worker threads. The executor is only destroyed once all of its nets have been.
+         */
+        ~Executor();
+
+        Executor(Executor const &) = delete;
+        Executor &operator=(Executor const &) = delete;
+
+        /**
+         * Returns the executor shared by the nets of the process which have been attached to it.
+         */
+        static std::shared_ptr<Executor> const &shared();
+
+        /**
+         * Returns the options controlling the worker threads.
+         */
+        WorkerOptions const &options() const;
+
+        /**
+         * Returns the current count of worker threads.
+         */
+        std::size_t threadCount() const;
+
+    private:
+        struct Internals;
+        std::unique_ptr<Internals> _internals;
+    };
+}
+
+#endif
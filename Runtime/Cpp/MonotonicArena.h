@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  MonotonicArena.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_MonotonicArena_h
+#define Petri_MonotonicArena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Petri {
+
+    /**
+     * Allocates memory by bumping a pointer into chunks of growing size, and releases all of it at
+     * once when destroyed. Individual allocations are never freed, so the arena suits objects which
+     * live as long as it does, such as the structure of a PetriNet.
+     * An arena is not thread safe.
+     */
+    class MonotonicArena {
+    public:
+        MonotonicArena() = default;
+        ~MonotonicArena();
+
+        MonotonicArena(MonotonicArena const &) = delete;
+        MonotonicArena &operator=(MonotonicArena const &) = delete;
+
+        /**
+         * Allocates a block of memory, which remains valid until the arena is destroyed.
+         * @param size The size of the block
+         * @param alignment The alignment of the block, which must be a power of 2
+         * @return The address of the block
+         */
+        void *allocate(std::size_t size, std::size_t alignment) {
+            auto address = (_current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            if(_chunk == nullptr || address + size > _end) {
+                return this->allocateChunk(size, alignment);
+            }
+
+            _current = address + size;
+            return reinterpret_cast<void *>(address);
+        }
+
+        /**
+         * Returns the count of bytes reserved from the system by the arena.
+         */
+        std::size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+    private:
+        // The first chunk is small, as many nets are small. The following ones double in size.
+        static constexpr std::size_t FirstChunkSize = 4096;
+        static constexpr std::size_t MaxChunkSize = 1024 * 1024;
+
+        struct Chunk {
+            Chunk *_previous;
+        };
+
+        void *allocateChunk(std::size_t size, std::size_t alignment);
+
+        Chunk *_chunk = nullptr;
+        std::uintptr_t _current = 0;
+        std::uintptr_t _end = 0;
+        std::size_t _capacity = 0;
+    };
+
+    /**
+     * A standard allocator taking its memory from a MonotonicArena, or from the free store if it
+     * has no arena.
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        ArenaAllocator(MonotonicArena *arena = nullptr) noexcept
+                : _arena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(ArenaAllocator<U> const &other) noexcept
+                : _arena(other.arena()) {}
+
+        T *allocate(std::size_t n) {
+            if(_arena != nullptr) {
+                return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n) noexcept {
+            if(_arena == nullptr) {
+                std::allocator<T>().deallocate(p, n);
+            }
+        }
+
+        MonotonicArena *arena() const noexcept {
+            return _arena;
+        }
+
+        template <typename U>
+        bool operator==(ArenaAllocator<U> const &other) const noexcept {
+            return _arena == other.arena();
+        }
+
+        template <typename U>
+        bool operator!=(ArenaAllocator<U> const &other) const noexcept {
+            return _arena != other.arena();
+        }
+
+    private:
+        MonotonicArena *_arena;
+    };
+
+    /**
+     * The deleter of a std::unique_ptr to an object which may have been created in a MonotonicArena.
+     * Such an object is only destroyed, as its memory is released with the arena.
+     */
+    template <typename T>
+    struct ArenaDeleter {
+        ArenaDeleter(bool inArena = false) noexcept
+                : _inArena(inArena) {}
+
+        void operator()(T *p) const {
+            if(_inArena) {
+                p->~T();
+            } else {
+                delete p;
+            }
+        }
+
+        bool _inArena;
+    };
+
+    template <typename T>
+    using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+    /**
+     * Creates an object in an arena, or in the free store if there is no arena.
+     * @param arena The arena, or nullptr
+     * @param args The arguments forwarded to the constructor of the object
+     * @return The new object
+     */
+    template <typename T, typename... Args>
+    ArenaPtr<T> makeArenaPtr(MonotonicArena *arena, Args &&... args) {
+        if(arena == nullptr) {
+            return ArenaPtr<T>(new T(std::forward<Args>(args)...));
+        }
+
+        auto memory = arena->allocate(sizeof(T), alignof(T));
+        return ArenaPtr<T>(new(memory) T(std::forward<Args>(args)...), ArenaDeleter<T>(true));
+    }
+}
+
+#endif
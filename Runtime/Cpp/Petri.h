@@ -32,8 +32,12 @@
 
 #include "Action.h"
 #include "DebugServer.h"
+#include "Executor.h"
 #include "PetriDebug.h"
 #include "PetriNet.h"
+#include "PetriNetBatch.h"
+#include "PetriNetTemplate.h"
 #include "PetriUtils.h"
+#include "TokenPayload.h"
 
 #endif
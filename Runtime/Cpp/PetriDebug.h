@@ -35,12 +35,13 @@
 namespace Petri {
 
     class DebugServer;
-    template <typename _ReturnType>
-    class ThreadPool;
+    class ExecutorQueue;
 
     class PetriDebug : public PetriNet {
     public:
         PetriDebug(std::string const &name);
+        PetriDebug(std::string const &name, WorkerOptions const &workerOptions);
+        PetriDebug(std::string const &name, std::shared_ptr<Executor> executor);
 
         virtual ~PetriDebug();
 
@@ -50,6 +51,7 @@ namespace Petri {
          * @param active Controls whether the action is active as soon as the net is started or not
          */
         virtual Action &addAction(Action action, bool active = false) override;
+        using PetriNet::addAction;
 
         /**
          * Sets the observer of the PetriDebug object. The observer will be notified by some of the
@@ -59,10 +61,10 @@ namespace Petri {
         void setObserver(DebugServer *session);
 
         /**
-         * Retrieves the underlying ThreadPool object.
-         * @return The underlying ThreadPool
+         * Retrieves the queue of the actions of the net on its executor, which can be paused.
+         * @return The queue of the actions
          */
-        ThreadPool<void> &actionsPool();
+        ExecutorQueue &actionsQueue();
 
         /**
          * Finds the state associated to the specified ID, or nullptr if not found.
@@ -32,6 +32,8 @@
 
 #include "DynamicLib.h"
 #include "PetriDebug.h"
+#include "PetriNetBatch.h"
+#include "PetriNetTemplate.h"
 #include "PetriUtils.h"
 #include <memory>
 
@@ -56,11 +58,21 @@ namespace Petri {
         virtual ~PetriDynamicLib();
 
         /**
-         * Creates the PetriNet object according to the code contained in the dynamic library.
+         * Creates the PetriNet object according to the code contained in the dynamic library. The
+         * net is instantiated from a template built on the first call, so that it only creates its
+         * variables. No action can be added to it.
          * @return The PetriNet object wrapped in a std::unique_ptr
          */
         std::unique_ptr<PetriNet> create();
 
+        /**
+         * Creates a batch of instances of the PetriNet contained in the dynamic library, which
+         * share the template of the nets returned by create().
+         * @param instances The count of instances
+         * @return The batch wrapped in a std::unique_ptr
+         */
+        std::unique_ptr<PetriNetBatch> createBatch(std::size_t instances);
+
         /**
          * Creates the PetriDebug object according to the code contained in the dynamic library.
          * @return The PetriDebug object wrapped in a std::unique_ptr
@@ -114,6 +126,11 @@ namespace Petri {
             _hashPtr = this->loadSymbol<char const *()>((prefix + "_getHash").c_str());
         }
 
+        /**
+         * Releases the template of the nets before unloading the dynamic library holding its code.
+         */
+        virtual void unload() override;
+
         /**
          * Gives access to the path of the dynamic library archive, relative to the executable path.
          * @return The relative path of the dylib
@@ -130,6 +147,13 @@ namespace Petri {
         char const *(*_hashPtr)() = nullptr;
 
         bool _c_dynamicLib;
+
+    private:
+        // Returns the template of the nets, which is built on the first call.
+        std::shared_ptr<PetriNetTemplate> petriNetTemplate();
+
+        // Built by the first call to create(), and only accessed atomically.
+        std::shared_ptr<PetriNetTemplate> _template;
     };
 }
 
@@ -30,16 +30,61 @@
 #ifndef Petri_PetriNet_h
 #define Petri_PetriNet_h
 
+#include "Callable.h"
+#include "Common.h"
+#include "TokenPayload.h"
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Petri {
 
     class Atomic;
+    class Executor;
+    class VariableHandle;
     class Action;
+    class PetriNet;
+
+    using ActionFunction = Function<actionResult_t(PetriNet &)>;
 
     class PetriNet {
+        friend class PetriNetBatch;
+        friend class PetriNetTemplate;
+
     public:
+        /**
+         * Controls when the transitions of an active state are evaluated again after a failed
+         * evaluation.
+         */
+        enum class EvaluationMode {
+            // Every transition is periodically evaluated, according to its delayBetweenEvaluation().
+            Polling,
+            // The transitions which depend on variables are only evaluated again when one of these
+            // variables changes. The transitions without variables are still periodically evaluated.
+            VariableChange,
+        };
+
+        /**
+         * Controls which threads execute the states of the net.
+         */
+        enum class ExecutionMode {
+            // The states are executed concurrently by the worker threads of the net.
+            Concurrent,
+            // The states are executed one at a time and in a reproducible order, by the thread
+            // calling step() or runUntilQuiescent(). The variables are neither locked nor observed,
+            // and must not be accessed by any other thread while the net is running.
+            Deterministic,
+            // The states are executed as in the Deterministic mode, against a virtual clock. The
+            // pauses of the actions and the delays between the evaluations of the transitions
+            // advance the clock instead of blocking the thread, so that the net runs as fast as
+            // possible in the order it would run in real time. All of the transitions are
+            // periodically evaluated, as in the Polling evaluation mode.
+            Simulated,
+        };
+
         /**
          * Creates the PetriNet, assigning it a name which serves debug purposes (see ThreadPool
          * constructor).
@@ -47,6 +92,25 @@ namespace Petri {
          */
         PetriNet(std::string const &name = "");
 
+        /**
+         * Creates the PetriNet, assigning it a name which serves debug purposes, and controlling the
+         * worker threads which execute its actions. The overflow policy applies to the states
+         * activated in parallel of the current ones. With OverflowPolicy::Reject, such a state
+         * activated while no worker is available is disabled without executing its action.
+         * @param name the name to assign to the PetriNet or a designated one if left empty
+         * @param workerOptions the bounds, stack size and idle timeout of the worker threads
+         */
+        PetriNet(std::string const &name, WorkerOptions const &workerOptions);
+
+        /**
+         * Creates the PetriNet, assigning it a name which serves debug purposes. Its actions are
+         * executed by the worker threads of an executor, which may be shared with other nets, such
+         * as Executor::shared(). The overflow policy of the executor applies to the net.
+         * @param name the name to assign to the PetriNet or a designated one if left empty
+         * @param executor the executor of the net
+         */
+        PetriNet(std::string const &name, std::shared_ptr<Executor> executor);
+
         virtual ~PetriNet();
 
         /**
@@ -56,6 +120,31 @@ namespace Petri {
          */
         virtual Action &addAction(Action action, bool active = false);
 
+        /**
+         * Creates an Action in the PetriNet. The storage of the action and of its transitions comes
+         * from an arena owned by the net, and is released at once with it. The net must not be
+         * running yet.
+         * @param id The ID of the new action.
+         * @param name The name of the new action.
+         * @param action The Function which will be called when the action is run.
+         * @param requiredTokens The number of tokens that must be inside the active action for it
+         * to execute.
+         * @param active Controls whether the action is active as soon as the net is started or not
+         */
+        Action &addAction(uint64_t id, std::string const &name, ActionFunction action, std::size_t requiredTokens, bool active = false);
+
+        /**
+         * Creates an Action in the PetriNet, as the previous method does. The action refers to its
+         * name instead of copying it.
+         * @param id The ID of the new action.
+         * @param name The name of the new action, which must outlive it.
+         * @param action The Function which will be called when the action is run.
+         * @param requiredTokens The number of tokens that must be inside the active action for it
+         * to execute.
+         * @param active Controls whether the action is active as soon as the net is started or not
+         */
+        Action &addAction(uint64_t id, InternedName name, ActionFunction action, std::size_t requiredTokens, bool active = false);
+
         /**
          * Checks whether the net is running.
          * @return true means that the net has been started, and we can not add any more action to
@@ -80,6 +169,40 @@ namespace Petri {
          */
         virtual void join();
 
+        /**
+         * Blocks the calling thread until the Petri net has completed its whole execution, or until
+         * the timeout expires.
+         * @param timeout The maximum duration to wait for
+         * @return true if the net has completed its execution, false if the timeout expired
+         */
+        bool joinFor(std::chrono::nanoseconds timeout);
+
+        /**
+         * Blocks the calling thread until the Petri net has completed its whole execution, or until
+         * the date is reached.
+         * @param date The date until which to wait
+         * @return true if the net has completed its execution, false if the date has been reached
+         */
+        template <typename Clock, typename Duration>
+        bool joinUntil(std::chrono::time_point<Clock, Duration> const &date) {
+            return this->joinFor(std::chrono::duration_cast<std::chrono::nanoseconds>(date - Clock::now()));
+        }
+
+        /**
+         * Returns a future which becomes ready once the Petri net has completed its whole execution,
+         * i.e. once join() would return.
+         * @return The completion future
+         */
+        std::future<void> completion();
+
+        /**
+         * Registers a callback invoked once the Petri net has completed its whole execution, on the
+         * thread that stopped it. If the net is not running, the callback is invoked immediately.
+         * The callback must neither destroy nor stop the net.
+         * @param callback The callback to invoke
+         */
+        void onCompletion(std::function<void()> callback);
+
         /**
          * Adds an Atomic variable designated by the specified id.
          * @param id the id of the new Atomic variable
@@ -93,6 +216,133 @@ namespace Petri {
          */
         Atomic &getVariable(std::uint_fast32_t id);
 
+        /**
+         * Gets a handle to an atomic variable previously added to the Petri net, to be kept by the
+         * code accessing the variable repeatedly. Trying to retrieve a non existing variable will
+         * throw an exception.
+         * @param id the id of the Atomic to retrieve.
+         * @return A handle to the variable, valid as long as the Petri net
+         */
+        VariableHandle variableHandle(std::uint_fast32_t id);
+
+        /**
+         * Changes the way the transitions of the active states are evaluated again. The net must
+         * not be running yet. In EvaluationMode::VariableChange mode, the condition of a
+         * transition associated to variables must only depend on these variables and on the
+         * result of the previous action.
+         * @param mode The new evaluation mode
+         */
+        void setEvaluationMode(EvaluationMode mode);
+
+        /**
+         * Returns the way the transitions of the active states are evaluated again.
+         * @return The current evaluation mode
+         */
+        EvaluationMode evaluationMode() const;
+
+        /**
+         * Changes the threads executing the states of the net. The net must not be running yet.
+         * @param mode The new execution mode
+         */
+        void setExecutionMode(ExecutionMode mode);
+
+        /**
+         * Returns the way the states of the net are executed.
+         * @return The current execution mode
+         */
+        ExecutionMode executionMode() const;
+
+        /**
+         * Returns the executor whose worker threads execute the actions of the net.
+         */
+        std::shared_ptr<Executor> const &executor() const;
+
+        /**
+         * Performs a single step of a net running in ExecutionMode::Deterministic or
+         * ExecutionMode::Simulated mode, on the calling thread. The oldest enabled state executes
+         * its action, and its transitions are evaluated. If no state is enabled, the transitions of
+         * the states waiting for one of them to be fulfilled are evaluated again, until some of them
+         * are crossed. In the Simulated mode, the next waiting state due is evaluated instead, after
+         * the virtual clock has been advanced to its date.
+         * @return false if the net is not running or nothing could be done, true otherwise
+         */
+        bool step();
+
+        /**
+         * Performs at most count steps of a net running in ExecutionMode::Deterministic or
+         * ExecutionMode::Simulated mode.
+         * @param count The maximum count of steps
+         * @return The count of steps performed
+         */
+        std::size_t step(std::size_t count);
+
+        /**
+         * Performs the steps of a net running in ExecutionMode::Deterministic or
+         * ExecutionMode::Simulated mode until it either completes, or waits for transitions which
+         * are not fulfilled. The net may then be stepped again later, once the conditions of these
+         * transitions may have changed.
+         * In the Simulated mode, the waiting states are evaluated until none of their transitions
+         * is crossed anymore. The conditions depending on the virtual time should be driven by
+         * advance() instead.
+         * @return The count of steps performed
+         */
+        std::size_t runUntilQuiescent();
+
+        /**
+         * Performs the steps of a net running in ExecutionMode::Simulated mode which are due before
+         * its virtual clock has advanced by the specified duration, and then sets the clock to the
+         * end of that duration, unless the net has completed.
+         * @param duration The duration to simulate
+         * @return The count of steps performed
+         */
+        std::size_t advance(std::chrono::nanoseconds duration);
+
+        /**
+         * Returns the virtual time elapsed since a net running in ExecutionMode::Simulated mode was
+         * started.
+         */
+        std::chrono::nanoseconds virtualTime() const;
+
+        /**
+         * Returns the pool from which the payloads of the tokens of the net are allocated.
+         */
+        PayloadPool &payloadPool();
+
+        /**
+         * Creates a payload holding a new object, to be sent by an action of the net.
+         * @param args The arguments forwarded to the constructor of the object
+         * @return The new payload
+         */
+        template <typename T, typename... Args>
+        TokenPayload makePayload(Args &&... args) {
+            return this->payloadPool().make<T>(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Takes the payloads of the tokens which activated the action executed by the calling
+         * thread, in the order they were sent. An action requiring several tokens receives one
+         * payload per token which had one. The payloads which are not taken are destroyed once the
+         * action returns. Must only be called by an action of the net.
+         * @return The received payloads
+         */
+        std::vector<TokenPayload> takePayloads();
+
+        /**
+         * Takes the first payload of the tokens which activated the action executed by the calling
+         * thread. Must only be called by an action of the net.
+         * @return The payload, or an empty one if there is none
+         */
+        TokenPayload takePayload();
+
+        /**
+         * Attaches a payload to the token sent by the action executed by the calling thread,
+         * replacing the previous one if any. The payload is moved to the successor reached through
+         * the first transition crossed, and the tokens sent through the other transitions carry no
+         * payload. Must only be called by an action of the net.
+         * @param payload The payload to send, which must come from the pool of the net
+         */
+        void sendPayload(TokenPayload payload);
+
         std::string const &name() const;
 
     protected:
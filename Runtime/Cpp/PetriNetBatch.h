@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetBatch.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_PetriNetBatch_h
+#define Petri_PetriNetBatch_h
+
+#include "PetriNet.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Petri {
+
+    class PetriNetTemplate;
+
+    /**
+     * Executes any count of independent instances of the net of a PetriNetTemplate on the calling
+     * thread, without a PetriNet per instance. The markings and the variables are stored as one
+     * array per state or variable, indexed by instance, and the engine sweeps each array across all
+     * of the instances at once.
+     * The instances are executed as in the Deterministic execution mode, a state running a single
+     * activation at a time in each instance. The callables of the states and transitions are given
+     * a net whose variables hold the ones of the current instance, and must only access the
+     * variables they have declared. The pauses of the actions are ignored.
+     */
+    class PetriNetBatch {
+    public:
+        /**
+         * The throughput of a batch since it was created or its counters were reset.
+         */
+        struct Statistics {
+            // The count of calls to step()
+            std::uint64_t sweeps = 0;
+            // The count of actions executed, all instances included
+            std::uint64_t actions = 0;
+            // The count of transition conditions evaluated
+            std::uint64_t evaluations = 0;
+            // The count of transitions crossed
+            std::uint64_t crossings = 0;
+            // The count of instances which have completed
+            std::uint64_t completions = 0;
+            // The time spent stepping the batch
+            std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+
+            /**
+             * Returns the count of actions executed per second of stepping.
+             */
+            double actionsPerSecond() const;
+        };
+
+        /**
+         * Creates a batch of instances of a template, whose variables hold the values of the
+         * variables of its prototype.
+         * @param petriNetTemplate The template of the instances
+         * @param instances The count of instances
+         */
+        PetriNetBatch(PetriNetTemplate const &petriNetTemplate, std::size_t instances);
+
+        ~PetriNetBatch();
+
+        PetriNetBatch(PetriNetBatch const &) = delete;
+        PetriNetBatch &operator=(PetriNetBatch const &) = delete;
+
+        /**
+         * Returns the count of instances of the batch.
+         */
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+        /**
+         * Returns the values of a variable, indexed by instance. They can be set before the batch
+         * is run, and read once it has been stepped.
+         * @param id The ID of the variable
+         * @return The first of the size() values of the variable
+         */
+        std::int64_t *values(std::uint_fast32_t id);
+
+        /**
+         * Starts every instance of the batch from the initial states of the net, which is done
+         * again if the batch has already been run. The variables are left as they are.
+         */
+        void run();
+
+        /**
+         * Performs a sweep across the instances. The states enabled in each instance execute their
+         * action, and then the transitions of the states waiting in each instance are evaluated.
+         * @return The count of actions executed and transitions crossed, which is 0 once no
+         * instance can progress anymore
+         */
+        std::size_t step();
+
+        /**
+         * Performs sweeps until no instance can progress anymore, as they have either completed or
+         * wait for transitions which are not fulfilled.
+         * @return The count of sweeps performed
+         */
+        std::size_t runUntilQuiescent();
+
+        /**
+         * Returns the count of instances which have not completed yet.
+         */
+        std::size_t activeInstances() const noexcept {
+            return _activeInstances;
+        }
+
+        /**
+         * Checks whether an instance has completed, i.e. has no active state left.
+         * @param instance The index of the instance
+         */
+        bool completed(std::size_t instance) const;
+
+        /**
+         * Returns the throughput counters of the batch.
+         */
+        Statistics const &statistics() const noexcept {
+            return _statistics;
+        }
+
+        /**
+         * Resets the throughput counters of the batch.
+         */
+        void resetStatistics() noexcept {
+            _statistics = Statistics();
+        }
+
+    private:
+        void runActions(std::uint32_t state);
+        void evaluateTransitions(std::uint32_t state);
+        // Copies the declared variables of an entity between an instance and the cursor.
+        void loadVariables(std::uint32_t begin, std::uint32_t end, std::size_t instance);
+        void storeVariables(std::uint32_t begin, std::uint32_t end, std::size_t instance);
+        // Gives a token to a state of an instance, and returns whether it has been activated.
+        bool addToken(std::uint32_t state, std::size_t instance);
+        void releaseActiveState(std::size_t instance);
+
+        std::shared_ptr<PetriNet const> _prototype;
+        // The net given to the callables, whose variables hold the ones of the current instance
+        std::unique_ptr<PetriNet> _cursor;
+        std::vector<std::int64_t *> _registers;
+
+        std::size_t const _size;
+        std::size_t _activeInstances = 0;
+
+        // Indexed by state and then by instance
+        std::vector<std::uint32_t> _tokens;
+        std::vector<std::uint32_t> _enabled;
+        std::vector<std::uint8_t> _waiting;
+        std::vector<actionResult_t> _results;
+        std::vector<std::uint64_t> _crossed;
+        // Indexed by state, the count of instances where the state is enabled or waiting
+        std::vector<std::size_t> _enabledInstances;
+        std::vector<std::size_t> _waitingInstances;
+
+        // Indexed by variable and then by instance
+        std::vector<std::int64_t> _values;
+
+        // Indexed by instance
+        std::vector<std::uint32_t> _activeStates;
+
+        // The instances selected by the current sweep of a state
+        std::vector<std::uint32_t> _selection;
+
+        Statistics _statistics;
+    };
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetTemplate.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_PetriNetTemplate_h
+#define Petri_PetriNetTemplate_h
+
+#include "PetriNet.h"
+#include <memory>
+
+namespace Petri {
+
+    /**
+     * The immutable structure of a PetriNet, from which any count of nets can be instantiated. The
+     * instances share the states and transitions of the template, and only own their variables,
+     * their tokens and their execution state, so that instantiating a net costs as much as creating
+     * its variables.
+     * The callables of the states and transitions are invoked concurrently by the instances, and
+     * must not depend on any state of their own.
+     */
+    class PetriNetTemplate {
+        friend class PetriNetBatch;
+
+    public:
+        /**
+         * Creates a template from a net, filled with its states, transitions and variables. The net
+         * becomes the prototype of the instances, and cannot be modified nor run anymore.
+         * @param prototype The net, which must not be running
+         */
+        explicit PetriNetTemplate(std::unique_ptr<PetriNet> prototype);
+
+        ~PetriNetTemplate();
+
+        PetriNetTemplate(PetriNetTemplate const &) = delete;
+        PetriNetTemplate &operator=(PetriNetTemplate const &) = delete;
+
+        /**
+         * Creates a net executing the states and transitions of the template. Its variables are
+         * created with the values of the ones of the prototype, and it runs with the same evaluation
+         * mode and execution mode. Its actions are executed by the executor of the prototype, which
+         * is shared by all of the instances. No action can be added to the net.
+         * @return The new net
+         */
+        std::unique_ptr<PetriNet> instantiate() const;
+
+        /**
+         * Creates a net executing the states and transitions of the template, as the previous
+         * method does, with worker threads of its own.
+         * @param workerOptions The bounds, stack size and idle timeout of the worker threads of the net
+         * @return The new net
+         */
+        std::unique_ptr<PetriNet> instantiate(WorkerOptions const &workerOptions) const;
+
+        /**
+         * Creates a net executing the states and transitions of the template, as the first method
+         * does, whose actions are executed by the specified executor.
+         * @param executor The executor of the net
+         * @return The new net
+         */
+        std::unique_ptr<PetriNet> instantiate(std::shared_ptr<Executor> executor) const;
+
+        /**
+         * Returns the name of the prototype, which is given to the instances.
+         */
+        std::string const &name() const;
+
+    private:
+        std::shared_ptr<PetriNet const> _prototype;
+    };
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  TokenPayload.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+
+#ifndef Petri_TokenPayload_h
+#define Petri_TokenPayload_h
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace Petri {
+
+    class PayloadPool;
+
+    /**
+     * The data carried by a token from an action to its successors. A payload owns an object
+     * taken from the PayloadPool of its net, and is only moved along the transitions, never
+     * copied. It must be destroyed before the pool it comes from.
+     */
+    class TokenPayload {
+        friend class PayloadPool;
+
+    public:
+        TokenPayload() noexcept = default;
+
+        TokenPayload(TokenPayload &&other) noexcept
+                : _block(other._block) {
+            other._block = nullptr;
+        }
+
+        TokenPayload &operator=(TokenPayload &&other) noexcept {
+            if(this != &other) {
+                this->reset();
+                _block = other._block;
+                other._block = nullptr;
+            }
+            return *this;
+        }
+
+        TokenPayload(TokenPayload const &) = delete;
+        TokenPayload &operator=(TokenPayload const &) = delete;
+
+        ~TokenPayload() {
+            this->reset();
+        }
+
+        /**
+         * Returns whether the payload holds an object.
+         */
+        explicit operator bool() const noexcept {
+            return _block != nullptr;
+        }
+
+        /**
+         * Returns whether the payload holds an object of the specified type.
+         */
+        template <typename T>
+        bool holds() const noexcept {
+            return _block != nullptr && *_block->_type == typeid(T);
+        }
+
+        /**
+         * Returns the object held by the payload, or nullptr if it is empty or holds an object of
+         * another type.
+         */
+        template <typename T>
+        T *get() noexcept {
+            return this->holds<T>() ? static_cast<T *>(_block->object()) : nullptr;
+        }
+        template <typename T>
+        T const *get() const noexcept {
+            return this->holds<T>() ? static_cast<T const *>(_block->object()) : nullptr;
+        }
+
+        /**
+         * Destroys the object held by the payload, and gives its memory back to its pool.
+         */
+        void reset() noexcept;
+
+    private:
+        // The header of the memory of a payload, which is followed by its object.
+        struct alignas(alignof(std::max_align_t)) Block {
+            PayloadPool *_pool;
+            std::type_info const *_type;
+            void (*_destroy)(void *);
+            std::size_t _sizeClass;
+
+            void *object() noexcept {
+                return this + 1;
+            }
+        };
+
+        explicit TokenPayload(Block *block) noexcept
+                : _block(block) {}
+
+        Block *_block = nullptr;
+    };
+
+    /**
+     * Allocates the payloads of the tokens of a net. The memory of a destroyed payload is kept to
+     * be reused by the next payload of a similar size, so that a net passing payloads along its
+     * transitions allocates nothing once it has warmed up.
+     * A pool is thread safe, and must outlive all of its payloads.
+     */
+    class PayloadPool {
+        friend class TokenPayload;
+
+    public:
+        PayloadPool() = default;
+        ~PayloadPool();
+
+        PayloadPool(PayloadPool const &) = delete;
+        PayloadPool &operator=(PayloadPool const &) = delete;
+
+        /**
+         * Creates a payload holding a new object.
+         * @param args The arguments forwarded to the constructor of the object
+         * @return The new payload
+         */
+        template <typename T, typename... Args>
+        TokenPayload make(Args &&... args) {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned payloads are not supported!");
+
+            auto block = this->allocate(sizeof(T));
+            try {
+                new(block->object()) T(std::forward<Args>(args)...);
+            } catch(...) {
+                this->recycle(block);
+                throw;
+            }
+            block->_type = &typeid(T);
+            block->_destroy = [](void *object) { static_cast<T *>(object)->~T(); };
+
+            return TokenPayload(block);
+        }
+
+        /**
+         * Returns the count of blocks of memory kept by the pool for the next payloads.
+         */
+        std::size_t available() const;
+
+    private:
+        // The sizes of the objects are rounded up to a multiple of the granularity. The larger
+        // objects are not pooled.
+        static constexpr std::size_t Granularity = alignof(std::max_align_t);
+        static constexpr std::size_t SizeClasses = 16;
+        static constexpr std::size_t Unpooled = SizeClasses;
+
+        TokenPayload::Block *allocate(std::size_t size);
+        void recycle(TokenPayload::Block *block) noexcept;
+
+        mutable std::mutex _mutex;
+        std::vector<TokenPayload::Block *> _free[SizeClasses];
+    };
+}
+
+#endif
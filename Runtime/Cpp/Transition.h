@@ -32,6 +32,7 @@
 
 #include "Callable.h"
 #include "Common.h"
+#include "MonotonicArena.h"
 #include <chrono>
 
 namespace Petri {
@@ -43,6 +44,7 @@ namespace Petri {
 
     using TransitionCallableBase = CallableBase<bool, actionResult_t>;
     using ParametrizedTransitionCallableBase = CallableBase<bool, PetriNet &, actionResult_t>;
+    using TransitionFunction = Function<bool(PetriNet &, actionResult_t)>;
 
     template <typename CallableType>
     auto make_transition_callable(CallableType &&c) {
@@ -76,7 +78,7 @@ namespace Petri {
          * Returns the condition associated to the Transition
          * @return The condition associated to the Transition
          */
-        ParametrizedTransitionCallableBase const &condition() const noexcept;
+        TransitionFunction const &condition() const noexcept;
 
         /**
          * Changes the condition associated to the Transition
@@ -84,6 +86,7 @@ namespace Petri {
          */
         void setCondition(TransitionCallableBase const &test);
         void setCondition(ParametrizedTransitionCallableBase const &test);
+        void setCondition(TransitionFunction test);
 
         /**
          * Gets the Action 'previous', the starting point of the Transition.
@@ -125,14 +128,21 @@ namespace Petri {
         void setDelayBetweenEvaluation(std::chrono::nanoseconds delay);
 
     private:
-        Transition(Action &previous, Action &next);
-        Transition(uint64_t id, std::string const &name, Action &previous, Action &next, ParametrizedTransitionCallableBase const &cond);
+        // The storage of the transition comes from the arena, unless it is nullptr.
+        Transition(MonotonicArena *arena, Action &previous, Action &next);
+        Transition(MonotonicArena *arena,
+                   uint64_t id,
+                   std::string const &name,
+                   Action &previous,
+                   Action &next,
+                   TransitionFunction cond);
+        Transition(MonotonicArena *arena, uint64_t id, InternedName name, Action &previous, Action &next, TransitionFunction cond);
 
         void setPrevious(Action &previous) noexcept;
         void setNext(Action &next) noexcept;
 
         struct Internals;
-        std::unique_ptr<Internals> _internals;
+        ArenaPtr<Internals> _internals;
     };
 }
 
@@ -28,29 +28,37 @@
 //
 
 #include "../Action.h"
+#include "EntityName.h"
+#include <atomic>
 #include <list>
-#include <mutex>
 
 namespace Petri {
 
     struct Action::Internals {
         Internals() = default;
-        Internals(std::string const &name, size_t requiredTokens)
-                : _name(name)
+        template <typename Name>
+        Internals(MonotonicArena *arena, Name const &name, size_t requiredTokens)
+                : _arena(arena)
+                , _transitions(arena)
+                , _transitionsLeadingToMe(arena)
+                , _name(name)
                 , _requiredTokens(requiredTokens) {}
-        std::list<Transition> _transitions;
-        std::list<std::reference_wrapper<Transition>> _transitionsLeadingToMe;
-        std::unique_ptr<ParametrizedActionCallableBase> _action;
-        std::string _name;
+
+        // The arena of the PetriNet which created the action, if any
+        MonotonicArena *_arena = nullptr;
+        TransitionList _transitions;
+        std::list<std::reference_wrapper<Transition>, ArenaAllocator<std::reference_wrapper<Transition>>> _transitionsLeadingToMe;
+        ActionFunction _action;
+        EntityName _name;
         std::size_t _requiredTokens = 1;
 
-        std::size_t _currentTokens = 0;
-        std::mutex _tokensMutex;
+        Counters _ownCounters;
+        Counters *_counters = &_ownCounters;
     };
 
     Action::Action()
             : Entity(0)
-            , _internals(std::make_unique<Internals>()) {}
+            , _internals(makeArenaPtr<Internals>(nullptr)) {}
 
     /**
      * Creates an empty action, associated to a copy of the specified Callable.
@@ -58,11 +66,11 @@ namespace Petri {
      */
     Action::Action(uint64_t id, std::string const &name, ActionCallableBase const &action, size_t requiredTokens)
             : Entity(id)
-            , _internals(std::make_unique<Internals>(name, requiredTokens)) {
+            , _internals(makeArenaPtr<Internals>(nullptr, nullptr, name, requiredTokens)) {
         this->setAction(action);
     }
     Action::Action(uint64_t id, std::string const &name, actionResult_t (*action)(), size_t requiredTokens)
-            : Action(id, name, make_action_callable(action), requiredTokens) {}
+            : Action(id, name, ActionFunction([action](PetriNet &) { return action(); }), requiredTokens) {}
 
     /**
      * Creates an empty action, associated to a copy of the specified Callable.
@@ -70,13 +78,33 @@ namespace Petri {
      */
     Action::Action(uint64_t id, std::string const &name, ParametrizedActionCallableBase const &action, size_t requiredTokens)
             : Entity(id)
-            , _internals(std::make_unique<Internals>(name, requiredTokens)) {
+            , _internals(makeArenaPtr<Internals>(nullptr, nullptr, name, requiredTokens)) {
         this->setAction(action);
     }
-    Action::Action(uint64_t id, std::string const &name, actionResult_t (*action)(PetriNet &), size_t requiredTokens)
-            : Action(id, name, make_param_action_callable(action), requiredTokens) {}
 
-    Action::Action(Action &&a) noexcept : Entity(a.ID()), _internals(std::move(a._internals)) {
+    /**
+     * Creates an empty action, associated to the specified Function.
+     * @param action The Function which will be moved
+     */
+    Action::Action(uint64_t id, std::string const &name, ActionFunction action, size_t requiredTokens)
+            : Entity(id)
+            , _internals(makeArenaPtr<Internals>(nullptr, nullptr, name, requiredTokens)) {
+        this->setAction(std::move(action));
+    }
+
+    Action::Action(MonotonicArena &arena, uint64_t id, std::string const &name, ActionFunction action, size_t requiredTokens)
+            : Entity(id)
+            , _internals(makeArenaPtr<Internals>(&arena, &arena, name, requiredTokens)) {
+        this->setAction(std::move(action));
+    }
+
+    Action::Action(MonotonicArena &arena, uint64_t id, InternedName name, ActionFunction action, size_t requiredTokens)
+            : Entity(id)
+            , _internals(makeArenaPtr<Internals>(&arena, &arena, name, requiredTokens)) {
+        this->setAction(std::move(action));
+    }
+
+    Action::Action(Action &&a) noexcept : Entity(std::move(a)), _internals(std::move(a._internals)) {
         for(auto &t : _internals->_transitions) {
             t.setPrevious(*this);
         }
@@ -96,30 +124,31 @@ namespace Petri {
     }
 
     Transition &Action::addTransition(Action &next) {
-        return this->addTransition(Transition(*this, next));
+        return this->addTransition(Transition(_internals->_arena, *this, next));
     }
 
     Transition &Action::addTransition(uint64_t id,
                                       std::string const &name,
                                       Action &next,
                                       ParametrizedTransitionCallableBase const &cond) {
-        return this->addTransition(Transition(id, name, *this, next, cond));
+        return this->addTransition(id, name, next, [copy = cond.copy_ptr()](PetriNet &pn, actionResult_t a) {
+            return (*copy)(pn, a);
+        });
     }
     Transition &
     Action::addTransition(uint64_t id, std::string const &name, Action &next, TransitionCallableBase const &cond) {
-        auto copy = cond.copy_ptr();
-        auto shared_copy = std::shared_ptr<TransitionCallableBase>(copy.release());
-        return this->addTransition(
-        id, name, next, make_param_transition_callable(std::move([shared_copy](PetriNet &, actionResult_t a) {
-            return shared_copy->operator()(a);
-        })));
+        return this->addTransition(id, name, next, [copy = cond.copy_ptr()](PetriNet &, actionResult_t a) {
+            return (*copy)(a);
+        });
     }
     Transition &Action::addTransition(uint64_t id, std::string const &name, Action &next, bool (*cond)(actionResult_t)) {
-        return addTransition(id, name, next, make_transition_callable(cond));
+        return this->addTransition(id, name, next, [cond](PetriNet &, actionResult_t a) { return cond(a); });
     }
-    Transition &
-    Action::addTransition(uint64_t id, std::string const &name, Action &next, bool (*cond)(PetriNet &, actionResult_t)) {
-        return addTransition(id, name, next, make_param_transition_callable(cond));
+    Transition &Action::addTransition(uint64_t id, std::string const &name, Action &next, TransitionFunction cond) {
+        return this->addTransition(Transition(_internals->_arena, id, name, *this, next, std::move(cond)));
+    }
+    Transition &Action::addTransition(uint64_t id, InternedName name, Action &next, TransitionFunction cond) {
+        return this->addTransition(Transition(_internals->_arena, id, name, *this, next, std::move(cond)));
     }
 
     /**
@@ -127,8 +156,8 @@ namespace Petri {
      * this method!
      * @return The Callable of the Action
      */
-    ParametrizedActionCallableBase &Action::action() noexcept {
-        return *_internals->_action;
+    ActionFunction &Action::action() noexcept {
+        return _internals->_action;
     }
 
     /**
@@ -136,13 +165,10 @@ namespace Petri {
      * @param action The Callable which will be copied and put in the Action
      */
     void Action::setAction(ActionCallableBase const &action) {
-        auto copy = action.copy_ptr();
-        auto shared_copy = std::shared_ptr<ActionCallableBase>(copy.release());
-        this->setAction(make_param_action_callable(
-        std::move([shared_copy](PetriNet &) { return shared_copy->operator()(); })));
+        this->setAction([copy = action.copy_ptr()](PetriNet &) { return (*copy)(); });
     }
     void Action::setAction(actionResult_t (*action)()) {
-        this->setAction(make_action_callable(action));
+        this->setAction([action](PetriNet &) { return action(); });
     }
 
     /**
@@ -150,10 +176,15 @@ namespace Petri {
      * @param action The Callable which will be copied and put in the Action
      */
     void Action::setAction(ParametrizedActionCallableBase const &action) {
-        _internals->_action = action.copy_ptr();
+        this->setAction([copy = action.copy_ptr()](PetriNet &pn) { return (*copy)(pn); });
     }
-    void Action::setAction(actionResult_t (*action)(PetriNet &)) {
-        this->setAction(make_param_action_callable(action));
+
+    /**
+     * Changes the Function associated to the Action
+     * @param action The Function which will be moved into the Action
+     */
+    void Action::setAction(ActionFunction action) {
+        _internals->_action = std::move(action);
     }
 
     /**
@@ -178,15 +209,28 @@ namespace Petri {
      * @return The current tokens count of the Action
      */
     std::size_t Action::currentTokens() noexcept {
-        return _internals->_currentTokens;
+        return _internals->_counters->_tokens;
     }
 
-    std::size_t &Action::currentTokensRef() noexcept {
-        return _internals->_currentTokens;
+    /**
+     * Gets the count of active instances of the Action, i.e. the tokens which have activated it and
+     * are executing it or waiting for one of its transitions to be fulfilled.
+     * @return The active instances count of the Action
+     */
+    std::size_t Action::activeCount() const noexcept {
+        return _internals->_counters->_active;
     }
 
-    std::mutex &Action::tokensMutex() noexcept {
-        return _internals->_tokensMutex;
+    Action::Counters &Action::counters() noexcept {
+        return *_internals->_counters;
+    }
+
+    void Action::setCounters(Counters &counters) noexcept {
+        if(&counters != _internals->_counters) {
+            counters._tokens = _internals->_counters->_tokens.load();
+            counters._active = _internals->_counters->_active.load();
+            _internals->_counters = &counters;
+        }
     }
 
     /**
@@ -194,7 +238,7 @@ namespace Petri {
      * @return The name of the Action
      */
     std::string const &Action::name() const noexcept {
-        return _internals->_name;
+        return _internals->_name.get();
     }
 
     /**
@@ -208,7 +252,7 @@ namespace Petri {
     /**
      * Returns the transitions exiting the Action.
      */
-    std::list<Transition> const &Action::transitions() const noexcept {
+    Action::TransitionList const &Action::transitions() const noexcept {
         return _internals->_transitions;
     }
 }
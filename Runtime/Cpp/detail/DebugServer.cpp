@@ -32,7 +32,7 @@
 #include "../DebugServer.h"
 #include "../PetriDynamicLib.h"
 #include "Socket.h"
-#include "ThreadPool.h"
+#include "ExecutorQueue.h"
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdocumentation"
@@ -426,9 +426,9 @@ namespace Petri {
             throw std::runtime_error("Petri net is not running!");
 
         if(pause) {
-            _petri->actionsPool().pause();
+            _petri->actionsQueue().pause();
         } else {
-            _petri->actionsPool().resume();
+            _petri->actionsQueue().resume();
         }
     }
 
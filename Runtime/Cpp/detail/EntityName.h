@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  EntityName.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_EntityName_h
+#define Petri_EntityName_h
+
+#include "../Common.h"
+#include <memory>
+#include <string>
+
+namespace Petri {
+
+    // The name of an action or a transition. It refers to an interned string, or to a copy owned
+    // by the entity. The empty names are never copied.
+    class EntityName {
+    public:
+        EntityName() noexcept
+                : EntityName(InternedName()) {}
+
+        explicit EntityName(InternedName name) noexcept
+                : _name(&name.get()) {}
+
+        explicit EntityName(std::string const &name)
+                : EntityName() {
+            *this = name;
+        }
+
+        EntityName &operator=(std::string const &name) {
+            if(name.empty()) {
+                _owned.reset();
+                _name = &InternedName().get();
+            } else {
+                _owned = std::make_unique<std::string>(name);
+                _name = _owned.get();
+            }
+
+            return *this;
+        }
+
+        std::string const &get() const noexcept {
+            return *_name;
+        }
+
+    private:
+        std::unique_ptr<std::string> _owned;
+        std::string const *_name;
+    };
+}
+
+#endif
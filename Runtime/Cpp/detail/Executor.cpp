@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  Executor.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "../Executor.h"
+#include "ExecutorQueue.h"
+#include <algorithm>
+#include <mutex>
+
+namespace Petri {
+
+    struct Executor::Internals {
+        Internals(WorkerOptions const &options, std::string const &name)
+                : _pool(options, name) {}
+
+        ~Internals() {
+            _pool.stop();
+        }
+
+        // A ticket is queued once for each task added to a queue. A worker taking it runs the next task of the
+        // round, which is not necessarily the one it was queued for.
+        void post() {
+            _pool.post([this]() { this->runNext(); }, WorkerOptions::OverflowPolicy::Queue);
+        }
+
+        void runNext();
+
+        // Runs a task of a queue on the calling thread, the task being already counted as running.
+        void run(ExecutorQueue &queue, TaskSlot &task);
+
+        // Accounts for the end of a task of a queue.
+        void finish(ExecutorQueue &queue);
+
+        // The queue whose task is being run by the calling thread, if any
+        static ExecutorQueue *&currentQueue() {
+            static thread_local ExecutorQueue *queue = nullptr;
+            return queue;
+        }
+
+        ThreadPool<void> _pool;
+
+        std::mutex _mutex;
+        // The queues with tasks to run, each of them running one task before going back to the end
+        // of the round.
+        std::deque<ExecutorQueue *> _round;
+    };
+
+    void Executor::Internals::runNext() {
+        ExecutorQueue *queue = nullptr;
+        TaskSlot *task = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            while(task == nullptr && !_round.empty()) {
+                queue = _round.front();
+                _round.pop_front();
+
+                // A paused queue leaves the round until it is resumed.
+                if(queue->_paused || queue->_tasks.empty()) {
+                    queue->_scheduled = false;
+                    continue;
+                }
+
+                task = queue->_tasks.front();
+                queue->_tasks.pop_front();
+                if(queue->_tasks.empty()) {
+                    queue->_scheduled = false;
+                } else {
+                    _round.push_back(queue);
+                }
+                ++queue->_running;
+            }
+        }
+
+        // The tickets outnumber the tasks when queues have been paused.
+        if(task == nullptr) {
+            return;
+        }
+
+        this->run(*queue, *task);
+    }
+
+    void Executor::Internals::run(ExecutorQueue &queue, TaskSlot &task) {
+        auto previous = currentQueue();
+        currentQueue() = &queue;
+        task.run();
+        currentQueue() = previous;
+
+        this->finish(queue);
+    }
+
+    void Executor::Internals::finish(ExecutorQueue &queue) {
+        std::lock_guard<std::mutex> lk(_mutex);
+        --queue._running;
+        if(queue._stopped) {
+            queue._idle.notify_all();
+        }
+    }
+
+    Executor::Executor(WorkerOptions const &options, std::string const &name)
+            : _internals(std::make_unique<Internals>(options, name)) {}
+
+    Executor::~Executor() = default;
+
+    std::shared_ptr<Executor> const &Executor::shared() {
+        static auto const executor = std::make_shared<Executor>();
+        return executor;
+    }
+
+    WorkerOptions const &Executor::options() const {
+        return _internals->_pool.options();
+    }
+
+    std::size_t Executor::threadCount() const {
+        return _internals->_pool.threadCount();
+    }
+
+    ExecutorQueue::ExecutorQueue(std::shared_ptr<Executor> executor)
+            : _executor(std::move(executor)) {
+        if(!_executor) {
+            throw std::runtime_error("Cannot create a queue without an executor!");
+        }
+    }
+
+    ExecutorQueue::~ExecutorQueue() {
+        this->stop();
+    }
+
+    bool ExecutorQueue::push(TaskSlot *task, WorkerOptions::OverflowPolicy overflowPolicy) {
+        auto &internals = *_executor->_internals;
+
+        if(internals._pool.overflows(overflowPolicy)) {
+            if(overflowPolicy == WorkerOptions::OverflowPolicy::Reject) {
+                task->discard();
+                return false;
+            }
+
+            // The task is run as if a worker had taken it from the queue, which does not run anything
+            // new once it has been paused or stopped.
+            bool runnable = false;
+            {
+                std::lock_guard<std::mutex> lk(internals._mutex);
+                if(!_stopped && !_paused) {
+                    ++_running;
+                    runnable = true;
+                }
+            }
+            if(runnable) {
+                if(ThreadPool<void>::runInline([&internals, this, task]() { internals.run(*this, *task); })) {
+                    return true;
+                }
+                internals.finish(*this);
+            }
+        }
+
+        bool ticket = false;
+        {
+            std::lock_guard<std::mutex> lk(internals._mutex);
+            if(!_stopped) {
+                _tasks.push_back(task);
+                task = nullptr;
+                // The tasks of a paused queue get their tickets when it is resumed.
+                ticket = !_paused;
+                if(ticket && !_scheduled) {
+                    internals._round.push_back(this);
+                    _scheduled = true;
+                }
+            }
+        }
+
+        // As with a stopped thread pool, the tasks of a stopped queue are never executed.
+        if(task != nullptr) {
+            task->discard();
+        } else if(ticket) {
+            internals.post();
+        }
+
+        return true;
+    }
+
+    void ExecutorQueue::pause() {
+        std::lock_guard<std::mutex> lk(_executor->_internals->_mutex);
+        if(!_stopped) {
+            _paused = true;
+        }
+    }
+
+    void ExecutorQueue::resume() {
+        auto &internals = *_executor->_internals;
+
+        std::size_t tickets = 0;
+        {
+            std::lock_guard<std::mutex> lk(internals._mutex);
+            if(!_paused) {
+                return;
+            }
+
+            _paused = false;
+            tickets = _tasks.size();
+            if(tickets > 0 && !_scheduled) {
+                internals._round.push_back(this);
+                _scheduled = true;
+            }
+        }
+
+        while(tickets-- > 0) {
+            internals.post();
+        }
+    }
+
+    void ExecutorQueue::stop() {
+        auto &internals = *_executor->_internals;
+
+        std::deque<TaskSlot *> dropped;
+        {
+            std::unique_lock<std::mutex> lk(internals._mutex);
+            _stopped = true;
+            _paused = false;
+            dropped.swap(_tasks);
+            if(_scheduled) {
+                internals._round.erase(std::find(internals._round.begin(), internals._round.end(), this));
+                _scheduled = false;
+            }
+
+            // A task of the queue may be stopping it.
+            std::size_t const current = Executor::Internals::currentQueue() == this ? 1 : 0;
+            _idle.wait(lk, [this, current]() { return _running <= current; });
+        }
+
+        for(auto task : dropped) {
+            task->discard();
+        }
+    }
+
+    bool ExecutorQueue::isCurrent() const {
+        return Executor::Internals::currentQueue() == this;
+    }
+}
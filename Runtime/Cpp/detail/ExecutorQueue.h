@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  ExecutorQueue.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_ExecutorQueue_h
+#define Petri_ExecutorQueue_h
+
+#include "../Executor.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+namespace Petri {
+
+    /**
+     * The tasks of a PetriNet waiting for a worker of its Executor. The queue is served in turn with
+     * the other queues of the executor, and can be paused and stopped on its own.
+     */
+    class ExecutorQueue {
+        friend struct Executor::Internals;
+
+    public:
+        ExecutorQueue(std::shared_ptr<Executor> executor);
+
+        /**
+         * Stops the queue, and waits for its running tasks to complete.
+         */
+        ~ExecutorQueue();
+
+        ExecutorQueue(ExecutorQueue const &) = delete;
+        ExecutorQueue &operator=(ExecutorQueue const &) = delete;
+
+        std::shared_ptr<Executor> const &executor() const {
+            return _executor;
+        }
+
+        /**
+         * Returns the options of the workers of the executor.
+         */
+        WorkerOptions const &options() const {
+            return _executor->options();
+        }
+
+        /**
+         * Adds a task to the queue.
+         * @param function The callable to be invoked with no argument. Its return value is ignored.
+         * @param overflowPolicy What to do with the task if all of the workers of the executor are
+         * busy and none can be added.
+         * @return false if the task has been rejected
+         */
+        template <typename Function>
+        bool post(Function &&function, WorkerOptions::OverflowPolicy overflowPolicy) {
+            return this->push(TaskSlot::make(std::forward<Function>(function)), overflowPolicy);
+        }
+
+        /**
+         * Returns whether the execution of the queue is paused.
+         */
+        bool paused() const {
+            return _paused;
+        }
+
+        /**
+         * Pauses the execution of the queue. The tasks that were already running are still executed,
+         * but the current and future queued tasks will remain queued until the resume() method is
+         * called. If the queue is stopped, this is a no-op.
+         */
+        void pause();
+
+        /**
+         * Resumes the execution of the queue. If it wasn't paused before, this is a no-op.
+         */
+        void resume();
+
+        /**
+         * Drops the queued tasks, and waits for the running ones to complete, but the one of the
+         * calling thread. The tasks added from now on are dropped.
+         */
+        void stop();
+
+        /**
+         * Returns whether the calling thread is running a task of the queue.
+         */
+        bool isCurrent() const;
+
+    private:
+        bool push(TaskSlot *task, WorkerOptions::OverflowPolicy overflowPolicy);
+
+        std::shared_ptr<Executor> const _executor;
+        std::atomic_bool _paused = {false};
+
+        // Protected by the mutex of the executor
+        std::deque<TaskSlot *> _tasks;
+        // Whether the queue is in the round of the executor
+        bool _scheduled = false;
+        bool _stopped = false;
+        std::size_t _running = 0;
+        std::condition_variable _idle;
+    };
+}
+
+#endif
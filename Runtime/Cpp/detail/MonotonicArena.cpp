@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  MonotonicArena.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "../MonotonicArena.h"
+#include <algorithm>
+
+namespace Petri {
+
+    constexpr std::size_t MonotonicArena::FirstChunkSize;
+    constexpr std::size_t MonotonicArena::MaxChunkSize;
+
+    MonotonicArena::~MonotonicArena() {
+        while(_chunk != nullptr) {
+            auto previous = _chunk->_previous;
+            ::operator delete(_chunk);
+            _chunk = previous;
+        }
+    }
+
+    void *MonotonicArena::allocateChunk(std::size_t size, std::size_t alignment) {
+        auto chunkSize = _chunk == nullptr ? FirstChunkSize : std::min(2 * _capacity, MaxChunkSize);
+        // The header of the chunk and the worst case padding of the block must fit as well.
+        chunkSize = std::max(chunkSize, sizeof(Chunk) + alignment + size);
+
+        auto chunk = static_cast<Chunk *>(::operator new(chunkSize));
+        chunk->_previous = _chunk;
+        _chunk = chunk;
+        _capacity += chunkSize;
+
+        _current = reinterpret_cast<std::uintptr_t>(chunk + 1);
+        _end = reinterpret_cast<std::uintptr_t>(chunk) + chunkSize;
+
+        return this->allocate(size, alignment);
+    }
+}
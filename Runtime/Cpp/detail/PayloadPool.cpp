@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PayloadPool.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+
+#include "../TokenPayload.h"
+
+namespace Petri {
+
+    void TokenPayload::reset() noexcept {
+        if(_block != nullptr) {
+            _block->_destroy(_block->object());
+            _block->_pool->recycle(_block);
+            _block = nullptr;
+        }
+    }
+
+    PayloadPool::~PayloadPool() {
+        for(auto &blocks : _free) {
+            for(auto block : blocks) {
+                ::operator delete(block);
+            }
+        }
+    }
+
+    std::size_t PayloadPool::available() const {
+        std::lock_guard<std::mutex> lk(_mutex);
+
+        std::size_t count = 0;
+        for(auto const &blocks : _free) {
+            count += blocks.size();
+        }
+        return count;
+    }
+
+    TokenPayload::Block *PayloadPool::allocate(std::size_t size) {
+        auto const sizeClass = size == 0 ? 0 : (size - 1) / Granularity;
+        if(sizeClass >= SizeClasses) {
+            auto block = static_cast<TokenPayload::Block *>(::operator new(sizeof(TokenPayload::Block) + size));
+            block->_pool = this;
+            block->_sizeClass = Unpooled;
+            return block;
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            auto &blocks = _free[sizeClass];
+            if(!blocks.empty()) {
+                auto block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+        }
+
+        auto block = static_cast<TokenPayload::Block *>(
+        ::operator new(sizeof(TokenPayload::Block) + (sizeClass + 1) * Granularity));
+        block->_pool = this;
+        block->_sizeClass = sizeClass;
+        return block;
+    }
+
+    void PayloadPool::recycle(TokenPayload::Block *block) noexcept {
+        if(block->_sizeClass != Unpooled) {
+            try {
+                std::lock_guard<std::mutex> lk(_mutex);
+                _free[block->_sizeClass].push_back(block);
+                return;
+            } catch(...) {
+                // The block is freed if it cannot be kept.
+            }
+        }
+
+        ::operator delete(block);
+    }
+}
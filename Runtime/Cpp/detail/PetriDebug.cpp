@@ -35,8 +35,8 @@
 namespace Petri {
 
     struct PetriDebug::Internals : PetriNet::Internals {
-        Internals(PetriDebug &pn, std::string const &name)
-                : PetriNet::Internals(pn, name) {}
+        Internals(PetriDebug &pn, std::string const &name, std::shared_ptr<Executor> executor)
+                : PetriNet::Internals(pn, name, std::move(executor)) {}
 
         void stateEnabled(Action &a) override;
         void stateDisabled(Action &a) override;
@@ -58,7 +58,11 @@ namespace Petri {
     }
 
     PetriDebug::PetriDebug(std::string const &name)
-            : PetriNet(std::make_unique<PetriDebug::Internals>(*this, name)) {}
+            : PetriDebug(name, WorkerOptions()) {}
+    PetriDebug::PetriDebug(std::string const &name, WorkerOptions const &workerOptions)
+            : PetriDebug(name, Internals::ownExecutor(name, workerOptions)) {}
+    PetriDebug::PetriDebug(std::string const &name, std::shared_ptr<Executor> executor)
+            : PetriNet(std::make_unique<PetriDebug::Internals>(*this, name, std::move(executor))) {}
 
     PetriDebug::~PetriDebug() = default;
 
@@ -88,7 +92,7 @@ namespace Petri {
             return nullptr;
     }
 
-    ThreadPool<void> &PetriDebug::actionsPool() {
-        return _internals->_actionsPool;
+    ExecutorQueue &PetriDebug::actionsQueue() {
+        return _internals->_actionsQueue;
     }
 }
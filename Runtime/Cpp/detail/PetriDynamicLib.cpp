@@ -39,14 +39,40 @@ namespace Petri {
             throw std::runtime_error("PetriDynamicLib::create: Dynamic library not loaded!");
         }
 
-        void *ptr = _createPtr();
+        return this->petriNetTemplate()->instantiate();
+    }
 
-        if(_c_dynamicLib) {
-            ::PetriNet *cPetriNet = static_cast<::PetriNet *>(ptr);
-            ptr = cPetriNet->owned.release();
+    std::unique_ptr<PetriNetBatch> PetriDynamicLib::createBatch(std::size_t instances) {
+        if(!this->loaded()) {
+            throw std::runtime_error("PetriDynamicLib::createBatch: Dynamic library not loaded!");
         }
 
-        return std::unique_ptr<PetriNet>(static_cast<PetriNet *>(ptr));
+        return std::make_unique<PetriNetBatch>(*this->petriNetTemplate(), instances);
+    }
+
+    std::shared_ptr<PetriNetTemplate> PetriDynamicLib::petriNetTemplate() {
+        auto prototype = std::atomic_load(&_template);
+        if(!prototype) {
+            void *ptr = _createPtr();
+
+            if(_c_dynamicLib) {
+                ::PetriNet *cPetriNet = static_cast<::PetriNet *>(ptr);
+                ptr = cPetriNet->owned.release();
+            }
+
+            // Two threads may build a template concurrently, in which case only one of them is kept.
+            auto created = std::make_shared<PetriNetTemplate>(std::unique_ptr<PetriNet>(static_cast<PetriNet *>(ptr)));
+            if(std::atomic_compare_exchange_strong(&_template, &prototype, created)) {
+                prototype = std::move(created);
+            }
+        }
+
+        return prototype;
+    }
+
+    void PetriDynamicLib::unload() {
+        std::atomic_store(&_template, std::shared_ptr<PetriNetTemplate>());
+        this->DynamicLib::unload();
     }
 
     std::unique_ptr<PetriDebug> PetriDynamicLib::createDebug() {
@@ -29,12 +29,115 @@
 
 #include "../PetriNet.h"
 #include "PetriNetImpl.h"
-#include "lock.h"
+#include "TokenContext.h"
+#include "VirtualDelay.h"
+#include <algorithm>
+#include <iterator>
 
 namespace Petri {
 
+    /**
+     * The outgoing transitions of an active state, waiting for one of them to be fulfilled. While
+     * none of them can be crossed, the state is parked and does not hold any worker thread.
+     */
+    struct PetriNet::Internals::WaitingState : std::enable_shared_from_this<WaitingState> {
+        enum class Status {
+            // Waiting for a variable change or a timer to be evaluated again
+            Parked,
+            // An evaluation has been queued on the thread pool
+            Scheduled,
+            Evaluating,
+            // A variable changed or a timer expired during the evaluation
+            EvaluatingAgain,
+            Done,
+        };
+
+        struct PendingTransition : Atomic::Observer {
+            PendingTransition(WaitingState &state, std::uint32_t transition, bool onVariableChange)
+                    : _state(state)
+                    , _transition(transition)
+                    , _onVariableChange(onVariableChange) {}
+
+            // Only used while the pending transitions are created, before they are subscribed to
+            // any variable.
+            PendingTransition(PendingTransition &&other) noexcept
+                    : _state(other._state)
+                    , _transition(other._transition)
+                    , _onVariableChange(other._onVariableChange) {}
+
+            void variableChanged(Atomic &) override {
+                _changed = true;
+                _state._internals.wakeUp(_state);
+            }
+
+            WaitingState &_state;
+            std::uint32_t const _transition;
+            bool const _onVariableChange;
+            bool _crossed = false;
+
+            // Only meaningful for transitions evaluated on variable change
+            std::atomic_bool _changed = {true};
+            // Only meaningful for polled transitions
+            ClockType::time_point _nextEvaluation = ClockType::time_point();
+        };
+
+        WaitingState(Internals &internals, std::uint32_t state, actionResult_t result)
+                : _internals(internals)
+                , _state(state)
+                , _result(result) {
+            auto const &frozen = _internals._topology->_states[state];
+            _transitions.reserve(frozen._transitionsEnd - frozen._transitionsBegin);
+            for(auto t = frozen._transitionsBegin; t != frozen._transitionsEnd; ++t) {
+                auto const &transition = _internals._topology->_transitions[t];
+                bool onVariableChange = _internals._evaluationMode == EvaluationMode::VariableChange &&
+                                        transition._variablesBegin != transition._variablesEnd;
+                _transitions.emplace_back(*this, t, onVariableChange);
+            }
+            _remaining = _transitions.size();
+        }
+
+        void subscribe() {
+            for(auto &pending : _transitions) {
+                if(pending._onVariableChange) {
+                    auto const &transition = _internals._topology->_transitions[pending._transition];
+                    for(auto v = transition._variablesBegin; v != transition._variablesEnd; ++v) {
+                        _internals.variable(_internals._topology->_variables[v]).subscribe(pending);
+                    }
+                }
+            }
+        }
+
+        void unsubscribe() {
+            for(auto &pending : _transitions) {
+                if(pending._onVariableChange) {
+                    auto const &transition = _internals._topology->_transitions[pending._transition];
+                    for(auto v = transition._variablesBegin; v != transition._variablesEnd; ++v) {
+                        _internals.variable(_internals._topology->_variables[v]).unsubscribe(pending);
+                    }
+                }
+            }
+        }
+
+        Internals &_internals;
+        std::uint32_t const _state;
+        actionResult_t const _result;
+        std::vector<PendingTransition> _transitions;
+        std::size_t _remaining;
+        // The payload sent by the action to its successors
+        TokenPayload _payload;
+
+        std::atomic<Status> _status = {Status::Evaluating};
+
+        // Only accessed by the thread evaluating or releasing the state
+        TimerWheel::TimerID _timer = 0;
+    };
+
     PetriNet::PetriNet(std::string const &name)
-            : PetriNet(std::make_unique<Internals>(*this, name)) {}
+            : PetriNet(name, WorkerOptions()) {}
+    PetriNet::PetriNet(std::string const &name, WorkerOptions const &workerOptions)
+            : PetriNet(name, Internals::ownExecutor(name, workerOptions)) {}
+    PetriNet::PetriNet(std::string const &name, std::shared_ptr<Executor> executor)
+            : PetriNet(std::make_unique<Internals>(*this, name, std::move(executor))) {}
     PetriNet::PetriNet(std::unique_ptr<Internals> internals)
             : _internals(std::move(internals)) {}
 
@@ -46,12 +149,23 @@ namespace Petri {
         if(this->running()) {
             throw std::runtime_error("Cannot modify running petri net!");
         }
+        if(_internals->_prototype) {
+            throw std::runtime_error("Cannot modify a petri net instantiated from a template!");
+        }
 
         _internals->_states.emplace_back(std::move(action), active);
 
         return _internals->_states.back().first;
     }
 
+    Action &PetriNet::addAction(uint64_t id, std::string const &name, ActionFunction action, std::size_t requiredTokens, bool active) {
+        return this->addAction(Action(_internals->_arena, id, name, std::move(action), requiredTokens), active);
+    }
+
+    Action &PetriNet::addAction(uint64_t id, InternedName name, ActionFunction action, std::size_t requiredTokens, bool active) {
+        return this->addAction(Action(_internals->_arena, id, name, std::move(action), requiredTokens), active);
+    }
+
     std::string const &PetriNet::name() const {
         return _internals->_name;
     }
@@ -61,16 +175,141 @@ namespace Petri {
     }
 
     void PetriNet::addVariable(std::uint_fast32_t id) {
-        _internals->_variables.emplace(std::make_pair(id, std::make_unique<Atomic>()));
+        if(_internals->findVariable(id) != nullptr) {
+            return;
+        }
+
+        auto variable = &_internals->_variables.emplace();
+        _internals->_indexedVariables.push_back(variable);
+        _internals->_variableIDs.push_back(id);
+
+        // The generated code numbers its variables from 0, so that they all end up in the dense index.
+        auto &dense = _internals->_denseVariables;
+        if(id < dense.size() || id < 2 * _internals->_variables.size() + 64) {
+            if(id >= dense.size()) {
+                dense.resize(id + 1, nullptr);
+            }
+            dense[id] = variable;
+        } else {
+            _internals->_sparseVariables.emplace(id, variable);
+        }
     }
 
     Atomic &PetriNet::getVariable(std::uint_fast32_t id) {
-        auto it = _internals->_variables.find(id);
-        if(it == _internals->_variables.end()) {
+        auto variable = _internals->findVariable(id);
+        if(variable == nullptr) {
             throw std::runtime_error("Non existing variable requested: " + std::to_string(id));
         }
 
-        return *it->second;
+        return *variable;
+    }
+
+    VariableHandle PetriNet::variableHandle(std::uint_fast32_t id) {
+        return VariableHandle(this->getVariable(id));
+    }
+
+    void PetriNet::setEvaluationMode(EvaluationMode mode) {
+        if(this->running()) {
+            throw std::runtime_error("Cannot modify running petri net!");
+        }
+
+        _internals->_evaluationMode = mode;
+    }
+
+    PetriNet::EvaluationMode PetriNet::evaluationMode() const {
+        return _internals->_evaluationMode;
+    }
+
+    void PetriNet::setExecutionMode(ExecutionMode mode) {
+        if(this->running()) {
+            throw std::runtime_error("Cannot modify running petri net!");
+        }
+
+        _internals->_executionMode = mode;
+    }
+
+    PetriNet::ExecutionMode PetriNet::executionMode() const {
+        return _internals->_executionMode;
+    }
+
+    std::shared_ptr<Executor> const &PetriNet::executor() const {
+        return _internals->_actionsQueue.executor();
+    }
+
+    bool PetriNet::step() {
+        return this->step(1) == 1;
+    }
+
+    std::size_t PetriNet::step(std::size_t count) {
+        if(_internals->_executionMode == ExecutionMode::Concurrent) {
+            throw std::runtime_error("Only a petri net in the Deterministic or Simulated execution mode can be stepped!");
+        }
+
+        // The variables may have been changed since the previous steps.
+        _internals->resetStalledStates();
+
+        std::size_t steps = 0;
+        while(steps < count && _internals->stepDeterministic()) {
+            ++steps;
+        }
+
+        return steps;
+    }
+
+    std::size_t PetriNet::runUntilQuiescent() {
+        return this->step(std::numeric_limits<std::size_t>::max());
+    }
+
+    std::size_t PetriNet::advance(std::chrono::nanoseconds duration) {
+        if(_internals->_executionMode != ExecutionMode::Simulated) {
+            throw std::runtime_error("Only a petri net in the Simulated execution mode can be advanced!");
+        }
+
+        auto const end = _internals->_virtualTime + duration;
+        auto const &timedStates = _internals->_timedStates;
+
+        std::size_t steps = 0;
+        while(this->running()) {
+            if(!_internals->_enabledStates.empty()) {
+                _internals->stepDeterministic();
+            } else if(!timedStates.empty() && timedStates.front()._date <= end) {
+                // The stalled states are evaluated all the same, as the time goes by.
+                _internals->evaluateTimedState();
+            } else {
+                _internals->_virtualTime = std::max(_internals->_virtualTime, end);
+                break;
+            }
+            ++steps;
+        }
+
+        return steps;
+    }
+
+    std::chrono::nanoseconds PetriNet::virtualTime() const {
+        return _internals->_virtualTime;
+    }
+
+    PayloadPool &PetriNet::payloadPool() {
+        return _internals->_payloadPool;
+    }
+
+    std::vector<TokenPayload> PetriNet::takePayloads() {
+        return std::move(TokenContext::of(*this).received());
+    }
+
+    TokenPayload PetriNet::takePayload() {
+        auto &received = TokenContext::of(*this).received();
+        if(received.empty()) {
+            return TokenPayload();
+        }
+
+        auto payload = std::move(received.front());
+        received.erase(received.begin());
+        return payload;
+    }
+
+    void PetriNet::sendPayload(TokenPayload payload) {
+        TokenContext::of(*this).sent() = std::move(payload);
     }
 
     void PetriNet::run() {
@@ -78,161 +317,740 @@ namespace Petri {
             throw std::runtime_error("Already running!");
         }
 
-        for(auto &p : _internals->_states) {
-            if(p.second) {
-                _internals->_running = true;
-                _internals->enableState(p.first);
-            }
+        if(!_internals->_prototype) {
+            _internals->freeze();
+        }
+        _internals->resetCounters();
+        _internals->_virtualTime = std::chrono::nanoseconds::zero();
+
+        auto const &initialStates = _internals->_topology->_initialStates;
+        if(initialStates.empty()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(_internals->_completionMutex);
+            _internals->_completed = false;
+            _internals->_running = true;
         }
+
+        // The net must not complete before all of its initial states have been enabled, even if the
+        // first ones terminate in the meantime.
+        ++_internals->_activeStates;
+
+        for(auto state : initialStates) {
+            _internals->enableState(state);
+        }
+
+        _internals->releaseActiveState();
     }
 
     void PetriNet::stop() {
-        if(this->running()) {
-            _internals->_running = false;
-            _internals->_activationCondition.notify_all();
+        // The net may be stopped concurrently by its last active state and by the user, only one of
+        // them being in charge of it.
+        if(!_internals->_running.exchange(false)) {
+            // The stopping thread waits for the tasks of the net, which must then not wait for it.
+            if(_internals->_actionsQueue.isCurrent()) {
+                return;
+            }
+            this->join();
         }
-        _internals->_actionsPool.stop();
+
+        std::lock_guard<std::mutex> stopLock(_internals->_stopMutex);
+        _internals->_actionsQueue.stop();
+        _internals->releaseWaitingStates();
+        _internals->releaseDeterministicStates();
+        _internals->releasePayloads();
+        // The timers of the net are cancelled, but one of them may still be firing.
+        _internals->_timerWheel.waitForCallbacks();
+
+        _internals->complete();
     }
 
     void PetriNet::join() {
-        // Quick and dirty…
-        while(this->running()) {
-            std::this_thread::sleep_for(std::chrono::nanoseconds(1'000'000));
+        std::unique_lock<std::mutex> lk(_internals->_completionMutex);
+        _internals->_completionCondition.wait(lk, [this]() { return _internals->_completed; });
+    }
+
+    bool PetriNet::joinFor(std::chrono::nanoseconds timeout) {
+        std::unique_lock<std::mutex> lk(_internals->_completionMutex);
+        return _internals->_completionCondition.wait_until(lk, ClockType::now() + timeout, [this]() {
+            return _internals->_completed;
+        });
+    }
+
+    std::future<void> PetriNet::completion() {
+        std::promise<void> promise;
+        auto future = promise.get_future();
+
+        std::lock_guard<std::mutex> lk(_internals->_completionMutex);
+        if(_internals->_completed) {
+            promise.set_value();
+        } else {
+            _internals->_completionPromises.push_back(std::move(promise));
         }
+
+        return future;
     }
 
-    void PetriNet::Internals::executeState(Action &state) {
-        Action *nextState = nullptr;
+    void PetriNet::onCompletion(std::function<void()> callback) {
+        {
+            std::lock_guard<std::mutex> lk(_internals->_completionMutex);
+            if(!_internals->_completed) {
+                _internals->_completionCallbacks.push_back(std::move(callback));
+                return;
+            }
+        }
+
+        callback();
+    }
+
+    void PetriNet::Internals::freeze() {
+        if(_states.size() >= NoState) {
+            throw std::runtime_error("Too many states in the petri net!");
+        }
 
+        std::unordered_map<Action const *, std::uint32_t> indices;
+        indices.reserve(_states.size());
+        for(auto &p : _states) {
+            indices.emplace(&p.first, static_cast<std::uint32_t>(indices.size()));
+        }
+
+        std::unordered_map<Atomic const *, std::uint32_t> variableIndices;
+        variableIndices.reserve(_indexedVariables.size());
+        for(auto atomic : _indexedVariables) {
+            variableIndices.emplace(atomic, static_cast<std::uint32_t>(variableIndices.size()));
+        }
+
+        Topology topology;
+        auto &states = topology._states;
+        auto &transitions = topology._transitions;
+        auto &variables = topology._variables;
+        states.reserve(_states.size());
+
+        // A variable is only left unlocked if all of the entities accessing it do it atomically.
+        std::unordered_set<std::uint32_t> lockedVariables;
+        auto findLockedVariables = [this, &variableIndices, &lockedVariables](Entity const &entity) {
+            for(auto id : entity.getVariables()) {
+                if(entity.locksVariable(id)) {
+                    lockedVariables.insert(variableIndices[&_this.getVariable(id)]);
+                }
+            }
+        };
+        for(auto &p : _states) {
+            findLockedVariables(p.first);
+            for(auto &t : p.first.transitions()) {
+                findLockedVariables(t);
+            }
+        }
+
+        // The variables of an entity are deduplicated and sorted by index, so that any two sets of
+        // variables are locked in the same order. A variable is locked exclusively as soon as the
+        // entity may modify it.
+        auto resolveVariables = [this, &variables, &variableIndices, &lockedVariables](Entity const &entity,
+                                                                                        std::uint32_t &begin,
+                                                                                        std::uint32_t &end) {
+            auto first = variables.size();
+            for(auto id : entity.getVariables()) {
+                auto index = variableIndices[&_this.getVariable(id)];
+                variables.push_back({index, entity.writesVariable(id), lockedVariables.count(index) > 0});
+            }
+            std::sort(variables.begin() + first, variables.end(), [](FrozenVariable const &v1, FrozenVariable const &v2) {
+                return v1._index < v2._index;
+            });
+
+            auto unique = variables.begin() + first;
+            for(auto v = unique; v != variables.end(); ++v) {
+                if(unique != variables.begin() + first && std::prev(unique)->_index == v->_index) {
+                    std::prev(unique)->_write = std::prev(unique)->_write || v->_write;
+                } else {
+                    *unique++ = *v;
+                }
+            }
+            variables.erase(unique, variables.end());
+
+            begin = static_cast<std::uint32_t>(first);
+            end = static_cast<std::uint32_t>(variables.size());
+        };
+
+        for(auto &p : _states) {
+            Action &action = p.first;
+            if(p.second) {
+                topology._initialStates.push_back(static_cast<std::uint32_t>(states.size()));
+            }
+
+            FrozenState state;
+            state._action = &action;
+            state._function = &action.action();
+            state._requiredTokens = action.requiredTokens();
+            resolveVariables(action, state._variablesBegin, state._variablesEnd);
+
+            state._transitionsBegin = static_cast<std::uint32_t>(transitions.size());
+            for(auto &t : action.transitions()) {
+                auto next = indices.find(&const_cast<Transition &>(t).next());
+                if(next == indices.end()) {
+                    throw std::runtime_error("The transition " + t.name() +
+                                             " leads to an action which is not part of the petri net!");
+                }
+
+                FrozenTransition transition;
+                transition._condition = &t.condition();
+                transition._next = next->second;
+                transition._delayBetweenEvaluation = t.delayBetweenEvaluation();
+                resolveVariables(t, transition._variablesBegin, transition._variablesEnd);
+                transitions.push_back(transition);
+            }
+            state._transitionsEnd = static_cast<std::uint32_t>(transitions.size());
+
+            states.push_back(state);
+        }
+
+        _frozen = std::move(topology);
+    }
+
+    void PetriNet::Internals::resetCounters() {
+        auto const &states = _topology->_states;
+        _counters = std::make_unique<Action::Counters[]>(states.size());
+
+        // The actions of a prototype are shared by all of its instances, which only count their own tokens.
+        if(!_prototype) {
+            for(std::size_t i = 0; i < states.size(); ++i) {
+                states[i]._action->setCounters(_counters[i]);
+            }
+        }
+    }
+
+    void PetriNet::Internals::complete() {
+        std::unique_lock<std::mutex> lk(_completionMutex);
+        if(_completed) {
+            return;
+        }
+
+        // The joining threads are only woken up once everything has been notified.
+        while(!_completionPromises.empty() || !_completionCallbacks.empty()) {
+            auto promises = std::move(_completionPromises);
+            auto callbacks = std::move(_completionCallbacks);
+            _completionPromises.clear();
+            _completionCallbacks.clear();
+            lk.unlock();
+
+            for(auto &promise : promises) {
+                promise.set_value();
+            }
+            for(auto &callback : callbacks) {
+                callback();
+            }
+
+            lk.lock();
+        }
+
+        _completed = true;
+        _completionCondition.notify_all();
+    }
+
+    void PetriNet::Internals::executeState(std::uint32_t state) {
+        for(std::size_t hops = 0; state != NoState; ++hops) {
+            // A long chain of states yields its worker from time to time, and a paused queue does
+            // not run anything new.
+            if(hops == MaxInlineSuccessors || (hops > 0 && _actionsQueue.paused())) {
+                this->executeStateLater(state, WorkerOptions::OverflowPolicy::Queue);
+                return;
+            }
+
+            state = this->executeAction(state);
+        }
+    }
+
+    std::uint32_t PetriNet::Internals::executeAction(std::uint32_t state) {
+        auto const &frozen = _topology->_states[state];
         actionResult_t res;
+        TokenPayload payload;
 
         {
-            std::vector<std::unique_lock<std::mutex>> locks;
-            locks.reserve(state.getVariables().size());
-            for(auto &var : state.getVariables()) {
-                locks.emplace_back(_this.getVariable(var).getLock());
-            }
+            TokenContext context(_this, payload);
+            this->receivePayloads(state, context.received());
 
-            lock(locks.begin(), locks.end());
+            VariablesLock lock(*this, frozen._variablesBegin, frozen._variablesEnd);
 
             // Runs the Callable
-            res = state.action()(_this);
+            res = (*frozen._function)(_this);
         }
 
-        if(!state.transitions().empty()) {
-            std::list<Transition *> transitionsToTest;
-            for(auto &t : state.transitions()) {
-                transitionsToTest.push_back(const_cast<Transition *>(&t));
+        for(auto v = frozen._variablesBegin; v != frozen._variablesEnd; ++v) {
+            if(_topology->_variables[v]._write) {
+                this->variable(_topology->_variables[v]).notifyChange();
             }
+        }
 
-            auto lastTest = ClockType::time_point();
+        if(frozen._transitionsBegin == frozen._transitionsEnd) {
+            this->disableState(state);
+            return NoState;
+        }
 
-            while(_running && transitionsToTest.size()) {
-                auto now = ClockType::now();
-                auto minDelay = ClockType::duration::max() / 2;
+        auto waitingState = std::make_shared<WaitingState>(*this, state, res);
+        waitingState->_payload = std::move(payload);
+        {
+            std::lock_guard<std::mutex> lk(_waitingStatesMutex);
+            _waitingStates.insert(waitingState);
+        }
+        waitingState->subscribe();
 
-                for(auto it = transitionsToTest.begin(); it != transitionsToTest.end();) {
-                    bool isFulfilled = false;
+        return this->evaluateTransitions(waitingState);
+    }
 
-                    if((now - lastTest) >= (*it)->delayBetweenEvaluation()) {
-                        {
-                            std::vector<std::unique_lock<std::mutex>> locks;
-                            locks.reserve((*it)->getVariables().size());
-                            for(auto &var : (*it)->getVariables()) {
-                                locks.emplace_back(_this.getVariable(var).getLock());
-                            }
+    std::uint32_t PetriNet::Internals::evaluateTransitions(std::shared_ptr<WaitingState> const &state) {
+        using Status = WaitingState::Status;
 
-                            lock(locks.begin(), locks.end());
+        // The state may have been released in the meantime, if the net has been stopped. On its first
+        // evaluation, the state may already have been notified of a change since it subscribed to its
+        // variables, and is then evaluated again by the loop below.
+        auto status = Status::Scheduled;
+        if(!state->_status.compare_exchange_strong(status, Status::Evaluating) && status != Status::Evaluating &&
+           status != Status::EvaluatingAgain) {
+            return NoState;
+        }
 
-                            // Testing the transition
-                            isFulfilled = (*it)->isFulfilled(_this, res);
-                        }
+        auto nextState = NoState;
+        bool forked = false;
+
+        while(_running) {
+            auto now = ClockType::now();
+            auto nextEvaluation = ClockType::time_point::max();
+
+            for(auto &pending : state->_transitions) {
+                if(pending._crossed) {
+                    continue;
+                }
+
+                auto const &transition = _topology->_transitions[pending._transition];
 
-                        minDelay = std::min(minDelay, (*it)->delayBetweenEvaluation());
-                    } else {
-                        minDelay = std::min(minDelay, (*it)->delayBetweenEvaluation() - (now - lastTest));
+                if(pending._onVariableChange) {
+                    if(!pending._changed.exchange(false)) {
+                        continue;
                     }
+                } else if(now < pending._nextEvaluation) {
+                    nextEvaluation = std::min(nextEvaluation, pending._nextEvaluation);
+                    continue;
+                }
 
-                    if(isFulfilled) {
-                        Action &a = (*it)->next();
-                        std::lock_guard<std::mutex> tokensLock(a.tokensMutex());
-                        if(++a.currentTokensRef() >= a.requiredTokens()) {
-                            a.currentTokensRef() -= a.requiredTokens();
+                bool isFulfilled = false;
+                {
+                    VariablesLock lock(*this, transition._variablesBegin, transition._variablesEnd);
 
-                            if(nextState == nullptr) {
-                                nextState = &a;
-                            } else {
-                                this->enableState(a);
-                            }
-                        }
+                    // Testing the transition
+                    isFulfilled = (*transition._condition)(_this, state->_result);
+                }
 
-                        it = transitionsToTest.erase(it);
-                    } else {
-                        ++it;
+                if(isFulfilled) {
+                    if(state->_payload) {
+                        this->forwardPayload(transition._next, std::move(state->_payload));
                     }
+                    if(this->addToken(transition._next)) {
+                        if(nextState == NoState) {
+                            nextState = transition._next;
+                        } else {
+                            this->enableState(transition._next);
+                            forked = true;
+                        }
+                    }
+
+                    pending._crossed = true;
+                    --state->_remaining;
+                } else if(!pending._onVariableChange) {
+                    pending._nextEvaluation = now + transition._delayBetweenEvaluation;
+                    nextEvaluation = std::min(nextEvaluation, pending._nextEvaluation);
                 }
+            }
 
-                if(nextState != nullptr) {
-                    break;
+            if(nextState != NoState || state->_remaining == 0) {
+                break;
+            }
+
+            if(nextEvaluation != ClockType::time_point::max()) {
+                this->scheduleWakeUp(*state, nextEvaluation);
+            }
+
+            status = Status::Evaluating;
+            if(state->_status.compare_exchange_strong(status, Status::Parked)) {
+                // From now on, the state may be evaluated again by another thread
+                return NoState;
+            }
+
+            // We have been woken up during the evaluation
+            state->_status = Status::Evaluating;
+        }
+
+        state->_status = Status::Done;
+        this->releaseWaitingState(*state);
+
+        if(nextState == NoState) {
+            this->disableState(state->_state);
+            return NoState;
+        }
+
+        this->swapStates(state->_state, nextState);
+        if(forked) {
+            // The successors run in parallel, and none of them should wait for the other ones.
+            this->executeStateLater(nextState, WorkerOptions::OverflowPolicy::Queue);
+            return NoState;
+        }
+
+        return nextState;
+    }
+
+    bool PetriNet::Internals::stepDeterministic() {
+        if(!_running) {
+            return false;
+        }
+
+        if(!_enabledStates.empty()) {
+            auto state = _enabledStates.front();
+            _enabledStates.pop_front();
+
+            auto const &frozen = _topology->_states[state];
+            auto const transitions = frozen._transitionsEnd - frozen._transitionsBegin;
+            auto const simulated = _executionMode == ExecutionMode::Simulated;
+
+            auto delay = std::chrono::nanoseconds::zero();
+            PendingState pending{state, {}, std::vector<bool>(transitions), transitions};
+            {
+                TokenContext context(_this, pending._payload);
+                this->receivePayloads(state, context.received());
+
+                if(simulated) {
+                    VirtualDelay pauses(delay);
+                    pending._result = (*frozen._function)(_this);
+                    this->resetStalledStates();
                 } else {
-                    lastTest = now;
+                    pending._result = (*frozen._function)(_this);
+                }
+            }
 
-                    while(ClockType::now() - lastTest <= minDelay) {
-                        std::this_thread::sleep_for(std::min(1000000ns, minDelay));
-                    }
+            if(transitions == 0) {
+                if(simulated && delay > std::chrono::nanoseconds::zero()) {
+                    // A final state only ends once the pauses of its action have elapsed.
+                    _timedStates.push_back(TimedState{_virtualTime + delay, _timedSequence++, std::move(pending)});
+                    std::push_heap(_timedStates.begin(), _timedStates.end());
+                } else {
+                    this->disableState(state);
+                }
+            } else if(simulated) {
+                // The transitions are first evaluated once the pauses of the action have elapsed.
+                pending._dates.assign(transitions, _virtualTime + delay);
+                if(delay == std::chrono::nanoseconds::zero()) {
+                    this->evaluateDeterministic(pending);
+                }
+                if(pending._remaining > 0) {
+                    this->scheduleTimedState(std::move(pending));
+                }
+            } else {
+                this->evaluateDeterministic(pending);
+                if(pending._remaining > 0) {
+                    _pendingStates.push_back(std::move(pending));
                 }
             }
+
+            return true;
         }
 
-        if(nextState != nullptr) {
-            this->swapStates(state, *nextState);
-        } else {
+        if(_executionMode == ExecutionMode::Simulated) {
+            if(_timedStates.empty() || _stalledStates == _timedStates.size()) {
+                return false;
+            }
+
+            this->evaluateTimedState();
+            return true;
+        }
+
+        // Nothing is enabled, so the pending states are evaluated again, in the order they started
+        // waiting.
+        auto pendingStates = std::move(_pendingStates);
+        _pendingStates.clear();
+
+        bool crossed = false;
+        for(auto &pending : pendingStates) {
+            crossed = this->evaluateDeterministic(pending) || crossed;
+            if(pending._remaining > 0) {
+                _pendingStates.push_back(std::move(pending));
+            }
+        }
+
+        return crossed;
+    }
+
+    bool PetriNet::Internals::evaluateDeterministic(PendingState &pending) {
+        auto const &frozen = _topology->_states[pending._state];
+        bool crossed = false;
+        bool handedOver = false;
+
+        for(std::size_t t = 0; t < pending._crossed.size(); ++t) {
+            auto const &transition = _topology->_transitions[frozen._transitionsBegin + t];
+            if(pending._crossed[t]) {
+                continue;
+            }
+            if(!pending._dates.empty()) {
+                if(pending._dates[t] > _virtualTime) {
+                    continue;
+                }
+                // The virtual clock must move forward between two evaluations.
+                pending._dates[t] = _virtualTime + std::max(transition._delayBetweenEvaluation, std::chrono::nanoseconds(1));
+            }
+            if(!(*transition._condition)(_this, pending._result)) {
+                continue;
+            }
+
+            pending._crossed[t] = true;
+            --pending._remaining;
+            crossed = true;
+
+            if(pending._payload) {
+                this->forwardPayload(transition._next, std::move(pending._payload));
+            }
+            if(this->addToken(transition._next)) {
+                if(handedOver) {
+                    this->enableState(transition._next);
+                } else {
+                    // The first successor inherits the activation of the state.
+                    this->swapStates(pending._state, transition._next);
+                    _enabledStates.push_back(transition._next);
+                    handedOver = true;
+                }
+            }
+        }
+
+        if(handedOver) {
+            pending._remaining = 0;
+        } else if(crossed && pending._remaining == 0) {
+            this->disableState(pending._state);
+        }
+
+        return crossed;
+    }
+
+    void PetriNet::Internals::evaluateTimedState() {
+        std::pop_heap(_timedStates.begin(), _timedStates.end());
+        auto timed = std::move(_timedStates.back());
+        _timedStates.pop_back();
+
+        _virtualTime = std::max(_virtualTime, timed._date);
+
+        auto &pending = timed._pending;
+        if(pending._crossed.empty()) {
+            this->disableState(pending._state);
+            return;
+        }
+
+        if(this->evaluateDeterministic(pending)) {
+            this->resetStalledStates();
+        } else if(pending._stalledEpoch != _simulationEpoch) {
+            pending._stalledEpoch = _simulationEpoch;
+            ++_stalledStates;
+        }
+
+        if(pending._remaining > 0) {
+            this->scheduleTimedState(std::move(pending));
+        }
+    }
+
+    void PetriNet::Internals::scheduleTimedState(PendingState pending) {
+        auto date = std::chrono::nanoseconds::max();
+        for(std::size_t t = 0; t < pending._crossed.size(); ++t) {
+            if(!pending._crossed[t]) {
+                date = std::min(date, pending._dates[t]);
+            }
+        }
+
+        _timedStates.push_back(TimedState{date, _timedSequence++, std::move(pending)});
+        std::push_heap(_timedStates.begin(), _timedStates.end());
+    }
+
+    void PetriNet::Internals::releaseDeterministicStates() {
+        auto enabledStates = std::move(_enabledStates);
+        auto pendingStates = std::move(_pendingStates);
+        auto timedStates = std::move(_timedStates);
+        _enabledStates.clear();
+        _pendingStates.clear();
+        _timedStates.clear();
+
+        for(auto state : enabledStates) {
             this->disableState(state);
         }
+        for(auto &pending : pendingStates) {
+            this->disableState(pending._state);
+        }
+        for(auto &timed : timedStates) {
+            this->disableState(timed._pending._state);
+        }
     }
 
-    void PetriNet::Internals::swapStates(Action &oldAction, Action &newAction) {
-        {
-            std::lock_guard<std::mutex> lk(_activationMutex);
-            _activeStates.insert(&newAction);
+    void PetriNet::Internals::wakeUp(WaitingState &state) {
+        using Status = WaitingState::Status;
 
-            auto it = _activeStates.find(&oldAction);
-            assert(it != _activeStates.end());
-            _activeStates.erase(it);
+        auto status = state._status.load();
+        while(true) {
+            switch(status) {
+                case Status::Parked:
+                    if(state._status.compare_exchange_weak(status, Status::Scheduled)) {
+                        // Evaluations are short, and must neither be lost nor run by the thread waking the state up.
+                        _actionsQueue.post(
+                        [this, s = state.shared_from_this()]() {
+                            auto next = this->evaluateTransitions(s);
+                            if(next != NoState) {
+                                this->executeState(next);
+                            }
+                        },
+                        WorkerOptions::OverflowPolicy::Queue);
+                        return;
+                    }
+                    break;
+                case Status::Evaluating:
+                    if(state._status.compare_exchange_weak(status, Status::EvaluatingAgain)) {
+                        return;
+                    }
+                    break;
+                case Status::Scheduled:
+                case Status::EvaluatingAgain:
+                case Status::Done:
+                    return;
+            }
         }
+    }
 
-        this->stateDisabled(oldAction);
-        this->stateEnabled(newAction);
+    void PetriNet::Internals::scheduleWakeUp(WaitingState &state, ClockType::time_point date) {
+        _timerWheel.cancel(state._timer);
+        state._timer = _timerWheel.schedule(date, [this, weak = std::weak_ptr<WaitingState>(state.shared_from_this())]() {
+            if(auto s = weak.lock()) {
+                this->wakeUp(*s);
+            }
+        });
+    }
+
+    void PetriNet::Internals::cancelWakeUp(WaitingState &state) {
+        _timerWheel.cancel(state._timer);
+        state._timer = 0;
+    }
+
+    void PetriNet::Internals::releaseWaitingState(WaitingState &state) {
+        state.unsubscribe();
+        this->cancelWakeUp(state);
 
-        _actionsPool.addTask(make_callable([this, &newAction]() { this->executeState(newAction); }));
+        std::lock_guard<std::mutex> lk(_waitingStatesMutex);
+        _waitingStates.erase(state.shared_from_this());
     }
 
-    void PetriNet::Internals::enableState(Action &a) {
+    void PetriNet::Internals::releaseWaitingStates() {
+        using Status = WaitingState::Status;
+
+        std::vector<std::shared_ptr<WaitingState>> states;
         {
-            std::lock_guard<std::mutex> lk(_activationMutex);
-            _activeStates.insert(&a);
+            std::lock_guard<std::mutex> lk(_waitingStatesMutex);
+            states.assign(_waitingStates.begin(), _waitingStates.end());
+        }
 
-            if(_actionsPool.threadCount() < _activeStates.size()) {
-                _actionsPool.addThread();
+        for(auto &state : states) {
+            // The states being evaluated are released by their evaluating thread.
+            auto status = state->_status.load();
+            while(status == Status::Parked || status == Status::Scheduled) {
+                if(state->_status.compare_exchange_weak(status, Status::Done)) {
+                    this->releaseWaitingState(*state);
+                    this->disableState(state->_state);
+                    break;
+                }
             }
         }
+    }
+
+    bool PetriNet::Internals::addToken(std::uint32_t state) noexcept {
+        auto const required = _topology->_states[state]._requiredTokens;
+        auto &tokens = _counters[state]._tokens;
+        auto current = tokens.load(std::memory_order_relaxed);
+        while(true) {
+            bool const enough = current + 1 >= required;
+            auto const desired = enough ? current + 1 - required : current + 1;
+            if(tokens.compare_exchange_weak(current, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return enough;
+            }
+        }
+    }
+
+    void PetriNet::Internals::forwardPayload(std::uint32_t state, TokenPayload payload) {
+        std::lock_guard<std::mutex> lk(_payloadsMutex);
+        if(_inboxes.empty()) {
+            _inboxes.resize(_topology->_states.size());
+        }
+
+        _inboxes[state].push_back(std::move(payload));
+        _pendingPayloads.fetch_add(1, std::memory_order_release);
+    }
+
+    void PetriNet::Internals::receivePayloads(std::uint32_t state, std::vector<TokenPayload> &payloads) {
+        if(_pendingPayloads.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lk(_payloadsMutex);
+        if(_inboxes.empty()) {
+            return;
+        }
+
+        // The tokens of a state are not told apart, so an activation takes the oldest payloads.
+        auto &inbox = _inboxes[state];
+        auto const count = std::min(inbox.size(), _topology->_states[state]._requiredTokens);
+        std::move(inbox.begin(), inbox.begin() + count, std::back_inserter(payloads));
+        inbox.erase(inbox.begin(), inbox.begin() + count);
+        _pendingPayloads.fetch_sub(count, std::memory_order_relaxed);
+    }
 
-        this->stateEnabled(a);
-        _actionsPool.addTask(make_callable([this, &a]() { this->executeState(a); }));
+    void PetriNet::Internals::releasePayloads() {
+        // The payloads are destroyed once the lock is released.
+        decltype(_inboxes) inboxes;
+        {
+            std::lock_guard<std::mutex> lk(_payloadsMutex);
+            inboxes.swap(_inboxes);
+            _pendingPayloads = 0;
+        }
     }
 
-    void PetriNet::Internals::disableState(Action &a) {
-        std::lock_guard<std::mutex> lk(_activationMutex);
+    void PetriNet::Internals::swapStates(std::uint32_t oldState, std::uint32_t newState) {
+        // The count of active states is left unchanged.
+        _counters[newState]._active.fetch_add(1, std::memory_order_relaxed);
+        _counters[oldState]._active.fetch_sub(1, std::memory_order_relaxed);
 
-        auto it = _activeStates.find(&a);
-        assert(it != _activeStates.end());
+        this->stateDisabled(*_topology->_states[oldState]._action);
+        this->stateEnabled(*_topology->_states[newState]._action);
+    }
 
-        _activeStates.erase(it);
+    void PetriNet::Internals::enableState(std::uint32_t state) {
+        ++_activeStates;
+        _counters[state]._active.fetch_add(1, std::memory_order_relaxed);
 
-        this->stateDisabled(a);
-        if(_activeStates.size() == 0 && _running) {
+        this->stateEnabled(*_topology->_states[state]._action);
+        if(_executionMode != ExecutionMode::Concurrent) {
+            _enabledStates.push_back(state);
+        } else {
+            this->executeStateLater(state, _actionsQueue.options().overflowPolicy);
+        }
+    }
+
+    void PetriNet::Internals::disableState(std::uint32_t state) {
+        _counters[state]._active.fetch_sub(1, std::memory_order_relaxed);
+        this->stateDisabled(*_topology->_states[state]._action);
+
+        this->releaseActiveState();
+    }
+
+    void PetriNet::Internals::releaseActiveState() {
+        if(--_activeStates == 0 && _running) {
             std::cout << "End of execution." << std::endl;
             _this.stop();
         }
     }
+
+    void PetriNet::Internals::executeStateLater(std::uint32_t state, WorkerOptions::OverflowPolicy overflowPolicy) {
+        if(!_actionsQueue.post([this, state]() { this->executeState(state); }, overflowPolicy)) {
+            std::cerr << "The action " << _topology->_states[state]._action->name()
+                      << " has been rejected, as no worker thread is available!" << std::endl;
+            this->disableState(state);
+        }
+    }
 }
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetBatch.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "../PetriNetBatch.h"
+#include "../PetriNetTemplate.h"
+#include "PetriNetImpl.h"
+#include "VirtualDelay.h"
+#include <algorithm>
+
+namespace Petri {
+
+    // The transitions crossed by a waiting state are recorded as a mask.
+    static constexpr std::uint32_t MaxTransitionsPerState = 64;
+
+    double PetriNetBatch::Statistics::actionsPerSecond() const {
+        auto const seconds = std::chrono::duration<double>(duration).count();
+        return seconds > 0 ? actions / seconds : 0;
+    }
+
+    PetriNetBatch::PetriNetBatch(PetriNetTemplate const &petriNetTemplate, std::size_t instances)
+            : _prototype(petriNetTemplate._prototype)
+            , _cursor(petriNetTemplate.instantiate())
+            , _size(instances) {
+        if(instances > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("Too many instances in the batch!");
+        }
+
+        auto const &topology = *_prototype->_internals->_topology;
+        for(auto const &state : topology._states) {
+            if(state._transitionsEnd - state._transitionsBegin > MaxTransitionsPerState) {
+                throw std::runtime_error("Cannot batch a state with more than 64 transitions!");
+            }
+        }
+
+        auto const states = topology._states.size();
+        _tokens.resize(states * _size);
+        _enabled.resize(states * _size);
+        _waiting.resize(states * _size);
+        _results.resize(states * _size);
+        _crossed.resize(states * _size);
+        _enabledInstances.resize(states);
+        _waitingInstances.resize(states);
+        _activeStates.resize(_size);
+        _selection.resize(_size);
+
+        auto const &cursor = *_cursor->_internals;
+        auto const variables = cursor._indexedVariables.size();
+        _values.resize(variables * _size);
+        for(std::size_t v = 0; v < variables; ++v) {
+            _registers.push_back(&cursor._indexedVariables[v]->value());
+            std::fill_n(_values.begin() + v * _size, _size, *_registers.back());
+        }
+    }
+
+    PetriNetBatch::~PetriNetBatch() = default;
+
+    std::int64_t *PetriNetBatch::values(std::uint_fast32_t id) {
+        auto const &ids = _cursor->_internals->_variableIDs;
+        auto it = std::find(ids.begin(), ids.end(), id);
+        if(it == ids.end()) {
+            throw std::runtime_error("No variable with this ID in the batch!");
+        }
+
+        return _values.data() + (it - ids.begin()) * _size;
+    }
+
+    void PetriNetBatch::run() {
+        std::fill(_tokens.begin(), _tokens.end(), 0);
+        std::fill(_enabled.begin(), _enabled.end(), 0);
+        std::fill(_waiting.begin(), _waiting.end(), 0);
+        std::fill(_enabledInstances.begin(), _enabledInstances.end(), 0);
+        std::fill(_waitingInstances.begin(), _waitingInstances.end(), 0);
+
+        auto const &initialStates = _prototype->_internals->_topology->_initialStates;
+        for(auto state : initialStates) {
+            auto enabled = _enabled.data() + state * _size;
+            for(std::size_t i = 0; i < _size; ++i) {
+                ++enabled[i];
+            }
+            _enabledInstances[state] = _size;
+        }
+
+        std::fill(_activeStates.begin(), _activeStates.end(), static_cast<std::uint32_t>(initialStates.size()));
+        _activeInstances = initialStates.empty() ? 0 : _size;
+    }
+
+    std::size_t PetriNetBatch::step() {
+        auto const start = ClockType::now();
+        auto const before = _statistics.actions + _statistics.crossings;
+
+        auto const states = static_cast<std::uint32_t>(_enabledInstances.size());
+        for(std::uint32_t s = 0; s < states; ++s) {
+            if(_enabledInstances[s] > 0) {
+                this->runActions(s);
+            }
+        }
+        for(std::uint32_t s = 0; s < states; ++s) {
+            if(_waitingInstances[s] > 0) {
+                this->evaluateTransitions(s);
+            }
+        }
+
+        ++_statistics.sweeps;
+        _statistics.duration += ClockType::now() - start;
+
+        return _statistics.actions + _statistics.crossings - before;
+    }
+
+    std::size_t PetriNetBatch::runUntilQuiescent() {
+        std::size_t sweeps = 0;
+        while(_activeInstances > 0 && this->step() > 0) {
+            ++sweeps;
+        }
+
+        return sweeps;
+    }
+
+    bool PetriNetBatch::completed(std::size_t instance) const {
+        return _activeStates.at(instance) == 0;
+    }
+
+    void PetriNetBatch::runActions(std::uint32_t state) {
+        auto const &frozen = _prototype->_internals->_topology->_states[state];
+        auto const base = state * _size;
+        auto enabled = _enabled.data() + base;
+        auto waiting = _waiting.data() + base;
+
+        // Selects the instances where the state can execute its action, without any branch.
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < _size; ++i) {
+            _selection[count] = static_cast<std::uint32_t>(i);
+            count += (enabled[i] != 0) & (waiting[i] == 0);
+        }
+
+        auto const hasTransitions = frozen._transitionsEnd != frozen._transitionsBegin;
+        auto pauses = std::chrono::nanoseconds::zero();
+        VirtualDelay ignoredPauses(pauses);
+
+        for(std::size_t k = 0; k < count; ++k) {
+            auto const i = _selection[k];
+
+            this->loadVariables(frozen._variablesBegin, frozen._variablesEnd, i);
+            auto result = (*frozen._function)(*_cursor);
+            this->storeVariables(frozen._variablesBegin, frozen._variablesEnd, i);
+
+            if(--enabled[i] == 0) {
+                --_enabledInstances[state];
+            }
+            if(hasTransitions) {
+                _results[base + i] = result;
+                _crossed[base + i] = 0;
+                waiting[i] = 1;
+                ++_waitingInstances[state];
+            } else {
+                this->releaseActiveState(i);
+            }
+        }
+
+        _statistics.actions += count;
+    }
+
+    void PetriNetBatch::evaluateTransitions(std::uint32_t state) {
+        auto const &topology = *_prototype->_internals->_topology;
+        auto const &frozen = topology._states[state];
+        auto const base = state * _size;
+        auto waiting = _waiting.data() + base;
+
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < _size; ++i) {
+            _selection[count] = static_cast<std::uint32_t>(i);
+            count += waiting[i];
+        }
+
+        auto const transitions = frozen._transitionsEnd - frozen._transitionsBegin;
+        auto const allCrossed = transitions == MaxTransitionsPerState ? ~std::uint64_t(0) : (std::uint64_t(1) << transitions) - 1;
+
+        for(std::size_t k = 0; k < count; ++k) {
+            auto const i = _selection[k];
+            auto &crossed = _crossed[base + i];
+            bool handedOver = false;
+
+            for(std::uint32_t t = 0; t < transitions; ++t) {
+                auto const bit = std::uint64_t(1) << t;
+                if(crossed & bit) {
+                    continue;
+                }
+
+                auto const &transition = topology._transitions[frozen._transitionsBegin + t];
+                this->loadVariables(transition._variablesBegin, transition._variablesEnd, i);
+                ++_statistics.evaluations;
+                bool const fulfilled = (*transition._condition)(*_cursor, _results[base + i]);
+                this->storeVariables(transition._variablesBegin, transition._variablesEnd, i);
+                if(!fulfilled) {
+                    continue;
+                }
+
+                crossed |= bit;
+                ++_statistics.crossings;
+                if(this->addToken(transition._next, i)) {
+                    ++_activeStates[i];
+                    handedOver = true;
+                }
+            }
+
+            // As in the Deterministic execution mode, the state is done once it has activated a
+            // successor, or crossed all of its transitions.
+            if(handedOver || crossed == allCrossed) {
+                waiting[i] = 0;
+                --_waitingInstances[state];
+                this->releaseActiveState(i);
+            }
+        }
+    }
+
+    void PetriNetBatch::loadVariables(std::uint32_t begin, std::uint32_t end, std::size_t instance) {
+        auto const &variables = _prototype->_internals->_topology->_variables;
+        for(auto v = begin; v != end; ++v) {
+            auto const index = variables[v]._index;
+            *_registers[index] = _values[index * _size + instance];
+        }
+    }
+
+    void PetriNetBatch::storeVariables(std::uint32_t begin, std::uint32_t end, std::size_t instance) {
+        auto const &variables = _prototype->_internals->_topology->_variables;
+        for(auto v = begin; v != end; ++v) {
+            if(variables[v]._write) {
+                auto const index = variables[v]._index;
+                _values[index * _size + instance] = *_registers[index];
+            }
+        }
+    }
+
+    bool PetriNetBatch::addToken(std::uint32_t state, std::size_t instance) {
+        auto const required = _prototype->_internals->_topology->_states[state]._requiredTokens;
+        auto const index = state * _size + instance;
+
+        if(++_tokens[index] < required) {
+            return false;
+        }
+
+        _tokens[index] -= static_cast<std::uint32_t>(required);
+        if(_enabled[index]++ == 0) {
+            ++_enabledInstances[state];
+        }
+
+        return true;
+    }
+
+    void PetriNetBatch::releaseActiveState(std::size_t instance) {
+        if(--_activeStates[instance] == 0) {
+            --_activeInstances;
+            ++_statistics.completions;
+        }
+    }
+}
@@ -33,54 +33,326 @@
 #include "../Action.h"
 #include "../Atomic.h"
 #include "../Common.h"
+#include "../Executor.h"
+#include "../MonotonicArena.h"
+#include "../TokenPayload.h"
 #include "../Transition.h"
-#include "ThreadPool.h"
+#include "ExecutorQueue.h"
+#include "TimerWheel.h"
+#include "VariableArena.h"
 #include <atomic>
 #include <cassert>
 #include <deque>
+#include <functional>
+#include <future>
+#include <limits>
 #include <list>
 #include <map>
 #include <mutex>
 #include <queue>
-#include <set>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Petri {
-    enum { InitialThreadsActions = 1 };
-    using ClockType =
-    std::conditional<std::chrono::high_resolution_clock::is_steady, std::chrono::high_resolution_clock, std::chrono::steady_clock>::type;
-
     struct PetriNet::Internals {
+        struct WaitingState;
 
-        Internals(PetriNet &pn, std::string const &name)
-                : _actionsPool(InitialThreadsActions, name.empty() ? "Anonymous PetriNet" : name)
+        Internals(PetriNet &pn, std::string const &name, std::shared_ptr<Executor> executor)
+                : _actionsQueue(std::move(executor))
+                , _timerWheel(TimerWheel::shared())
                 , _name(name.empty() ? "Anonymous PetriNet" : name)
                 , _this(pn) {}
         virtual ~Internals() {}
 
-        // This method is executed concurrently on the thread pool.
-        virtual void executeState(Action &a);
+        // Creates the executor of a net which does not share one, named after the net.
+        static std::shared_ptr<Executor> ownExecutor(std::string const &name, WorkerOptions const &workerOptions) {
+            return std::make_shared<Executor>(workerOptions, name.empty() ? "Anonymous PetriNet" : name);
+        }
+
+        // The count of successive states a worker runs before queueing the next one.
+        static constexpr std::size_t MaxInlineSuccessors = 64;
+
+        // Designates no state, where a state index is expected.
+        static constexpr std::uint32_t NoState = std::numeric_limits<std::uint32_t>::max();
+
+        // A state of the net, as flattened by freeze().
+        struct FrozenState {
+            Action *_action;
+            ActionFunction *_function;
+            std::size_t _requiredTokens;
+            // The outgoing transitions, in _frozenTransitions
+            std::uint32_t _transitionsBegin;
+            std::uint32_t _transitionsEnd;
+            // In _frozenVariables
+            std::uint32_t _variablesBegin;
+            std::uint32_t _variablesEnd;
+        };
+
+        // A transition of the net, as flattened by freeze().
+        struct FrozenTransition {
+            TransitionFunction const *_condition;
+            std::uint32_t _next;
+            // In _frozenVariables
+            std::uint32_t _variablesBegin;
+            std::uint32_t _variablesEnd;
+            std::chrono::nanoseconds _delayBetweenEvaluation;
+        };
+
+        // A variable of a state or a transition, as resolved by freeze().
+        struct FrozenVariable {
+            // In _indexedVariables
+            std::uint32_t _index;
+            // Whether the entity may modify the variable, or only reads it
+            bool _write;
+            // Whether the variable is locked at all, or only accessed atomically by every entity
+            bool _lock;
+        };
+
+        // The structure of a net, as flattened by freeze(). It is shared by the nets instantiated from
+        // a PetriNetTemplate, and never modified once built.
+        struct Topology {
+            std::vector<FrozenState> _states;
+            std::vector<FrozenTransition> _transitions;
+            std::vector<FrozenVariable> _variables;
+            // The states active as soon as the net is started
+            std::vector<std::uint32_t> _initialStates;
+        };
+
+        // A state whose action has been run in the Deterministic or Simulated execution mode, and
+        // which waits for one of its transitions to be fulfilled.
+        struct PendingState {
+            std::uint32_t _state;
+            actionResult_t _result;
+            // Indexed as the transitions of the state
+            std::vector<bool> _crossed;
+            std::size_t _remaining;
+            // In the Simulated execution mode, the virtual date of the next evaluation of each
+            // transition
+            std::vector<std::chrono::nanoseconds> _dates;
+            // In the Simulated execution mode, the value of _simulationEpoch when none of the
+            // transitions of the state could be crossed
+            std::uint64_t _stalledEpoch;
+            // The payload sent by the action to its successors
+            TokenPayload _payload;
+        };
+
+        // A state pending in the Simulated execution mode, ordered by the virtual date of its next
+        // evaluation, and then by the order it was scheduled in.
+        struct TimedState {
+            std::chrono::nanoseconds _date;
+            std::uint64_t _sequence;
+            PendingState _pending;
+
+            bool operator<(TimedState const &other) const {
+                // std::push_heap() keeps the greatest element first.
+                return std::tie(_date, _sequence) > std::tie(other._date, other._sequence);
+            }
+        };
+
+        // Locks the variables of a state or a transition for the lifetime of the object. They are
+        // acquired one after the other in the order set by freeze(), which avoids deadlocks without
+        // any retry. The variables which are only read are shared with the other readers.
+        class VariablesLock {
+        public:
+            VariablesLock(Internals const &internals, std::uint32_t begin, std::uint32_t end)
+                    : _internals(internals)
+                    , _begin(internals._topology->_variables.data() + begin)
+                    , _end(internals._topology->_variables.data() + end) {
+                for(auto v = _begin; v != _end; ++v) {
+                    if(!v->_lock) {
+                        continue;
+                    } else if(v->_write) {
+                        _internals.variable(*v).getMutex().lock();
+                    } else {
+                        _internals.variable(*v).getMutex().lock_shared();
+                    }
+                }
+            }
+
+            ~VariablesLock() {
+                for(auto v = _end; v != _begin;) {
+                    --v;
+                    if(!v->_lock) {
+                        continue;
+                    } else if(v->_write) {
+                        _internals.variable(*v).getMutex().unlock();
+                    } else {
+                        _internals.variable(*v).getMutex().unlock_shared();
+                    }
+                }
+            }
+
+            VariablesLock(VariablesLock const &) = delete;
+            VariablesLock &operator=(VariablesLock const &) = delete;
+
+        private:
+            Internals const &_internals;
+            FrozenVariable const *const _begin;
+            FrozenVariable const *const _end;
+        };
+
+        // Flattens the states, transitions and variables of the net into the topology walked by the
+        // executor. Called when the net is run, as it cannot be modified while it is running, unless
+        // the net shares the topology of its prototype.
+        void freeze();
+        // Gives fresh counters to the states of the topology.
+        void resetCounters();
+
+        // This method is executed concurrently on the thread pool. The state's successor runs on the
+        // same worker right after it, as long as it is its only successor.
+        void executeState(std::uint32_t state);
+        // Runs the action of a state and evaluates its transitions, and returns the successor to run
+        // next on the same worker, if any.
+        virtual std::uint32_t executeAction(std::uint32_t state);
 
         virtual void stateEnabled(Action &) {}
         virtual void stateDisabled(Action &) {}
 
-        void enableState(Action &a);
-        void disableState(Action &a);
-        void swapStates(Action &oldAction, Action &newAction);
+        // Gives a token to a state, and atomically consumes its required tokens if it now has enough
+        // of them. Returns whether the state must be activated.
+        bool addToken(std::uint32_t state) noexcept;
+        void enableState(std::uint32_t state);
+        void disableState(std::uint32_t state);
+        // Queues a payload for the next activation of a state. Must be called before the token
+        // carrying it is given to the state.
+        void forwardPayload(std::uint32_t state, TokenPayload payload);
+        // Takes the payloads queued for a state which has just been activated, one per required
+        // token at most.
+        void receivePayloads(std::uint32_t state, std::vector<TokenPayload> &payloads);
+        // Destroys the payloads which have not been received.
+        void releasePayloads();
+        // Decrements the count of active states, and stops the net once it drops to 0.
+        void releaseActiveState();
+        // Hands over the activation of a state to its successor, which the caller must execute.
+        void swapStates(std::uint32_t oldState, std::uint32_t newState);
+        // Queues the execution of the action of a state which has just been activated.
+        void executeStateLater(std::uint32_t state, WorkerOptions::OverflowPolicy overflowPolicy);
+
+        // Runs the oldest enabled state, or evaluates again the pending ones in the Deterministic
+        // and Simulated execution modes. Returns whether anything was done.
+        bool stepDeterministic();
+        // Crosses the fulfilled transitions of a pending state, and returns whether any was crossed.
+        // In the Simulated execution mode, only the transitions due are evaluated. The state has
+        // nothing left to wait for once its remaining transitions drop to 0.
+        bool evaluateDeterministic(PendingState &pending);
+        // Advances the virtual clock to the earliest pending state of the Simulated execution mode,
+        // and evaluates it.
+        void evaluateTimedState();
+        // Queues a pending state until the earliest virtual date one of its transitions is due.
+        void scheduleTimedState(PendingState pending);
+        // Notes that the net has changed, so that its pending states may have to be evaluated again
+        // before it is considered quiescent.
+        void resetStalledStates() noexcept {
+            ++_simulationEpoch;
+            _stalledStates = 0;
+        }
+        // Disables the states enabled or pending in the Deterministic and Simulated execution modes.
+        void releaseDeterministicStates();
+
+        // Evaluates the transitions of a waiting state, and parks it if none of them can be crossed.
+        // Returns the successor the caller must execute, if any.
+        std::uint32_t evaluateTransitions(std::shared_ptr<WaitingState> const &state);
+        // Queues the evaluation of a parked state after one of its transitions may have become fulfilled.
+        void wakeUp(WaitingState &state);
+        void scheduleWakeUp(WaitingState &state, ClockType::time_point date);
+        void cancelWakeUp(WaitingState &state);
+        void releaseWaitingState(WaitingState &state);
+        void releaseWaitingStates();
+        // Wakes up the joining threads and notifies the completion of the execution.
+        void complete();
 
-        std::condition_variable _activationCondition;
-        std::multiset<Action *> _activeStates;
-        std::mutex _activationMutex;
+        // The storage of the structure of the net. Declared first, so that it outlives everything
+        // allocated from it.
+        MonotonicArena _arena;
+        // Declared before the states, so that it outlives the payloads they carry.
+        PayloadPool _payloadPool;
 
+        // Count of the active states, each of them being also counted by its action. The net stops
+        // when it drops to 0.
+        std::atomic<std::size_t> _activeStates = {0};
+
+        // Cleared by the single thread stopping the net, which holds the mutex while releasing it.
         std::atomic_bool _running = {false};
-        ThreadPool<void> _actionsPool;
+        std::mutex _stopMutex;
+        // Only the states executing their action or evaluating their transitions hold a worker
+        // thread of the executor. The waiting states are parked.
+        ExecutorQueue _actionsQueue;
+
+        EvaluationMode _evaluationMode = EvaluationMode::Polling;
+        ExecutionMode _executionMode = ExecutionMode::Concurrent;
+        std::unordered_set<std::shared_ptr<WaitingState>> _waitingStates;
+        std::mutex _waitingStatesMutex;
+
+        // Only accessed by the thread stepping the net, in the Deterministic and Simulated execution
+        // modes
+        std::deque<std::uint32_t> _enabledStates;
+        std::vector<PendingState> _pendingStates;
+        // A heap, in the Simulated execution mode
+        std::vector<TimedState> _timedStates;
+        std::uint64_t _timedSequence = 0;
+        std::chrono::nanoseconds _virtualTime = std::chrono::nanoseconds::zero();
+        // The count of pending states which have been evaluated without crossing any transition
+        // since the last change of the net. The net is quiescent once all of them have.
+        std::uint64_t _simulationEpoch = 1;
+        std::size_t _stalledStates = 0;
+
+        // Protected by _completionMutex
+        bool _completed = true;
+        std::vector<std::promise<void>> _completionPromises;
+        std::vector<std::function<void()>> _completionCallbacks;
+        std::mutex _completionMutex;
+        std::condition_variable _completionCondition;
+
+        // The delayed evaluations of all the nets are served by a single timer thread.
+        TimerWheel &_timerWheel;
 
         std::string const _name;
-        std::list<std::pair<Action, bool>> _states;
+
+        // Built by freeze()
+        Topology _frozen;
+        // The topology the net executes, which is either its own or the one of its prototype
+        Topology const *_topology = &_frozen;
+        // The net whose states and transitions are executed by this one, if it has been instantiated
+        // from a PetriNetTemplate
+        std::shared_ptr<PetriNet const> _prototype;
+        // The counters of the actions, indexed as the states of the topology
+        std::unique_ptr<Action::Counters[]> _counters;
+        // The payloads sent to each state and not received yet, indexed as the states of the
+        // topology once the first payload is sent. _pendingPayloads counts them, so that the
+        // activations do not lock _payloadsMutex as long as no payload is used.
+        std::vector<std::vector<TokenPayload>> _inboxes;
+        std::atomic<std::size_t> _pendingPayloads = {0};
+        std::mutex _payloadsMutex;
+
+        using States = std::list<std::pair<Action, bool>, ArenaAllocator<std::pair<Action, bool>>>;
+        States _states{States::allocator_type(&_arena)};
         std::list<Transition> _transitions;
 
-        std::map<std::uint_fast32_t, std::unique_ptr<Atomic>> _variables;
+        // Returns the variable designated by an ID, or nullptr if there is none.
+        Atomic *findVariable(std::uint_fast32_t id) const {
+            if(id < _denseVariables.size() && _denseVariables[id] != nullptr) {
+                return _denseVariables[id];
+            }
+            auto it = _sparseVariables.find(id);
+            return it == _sparseVariables.end() ? nullptr : it->second;
+        }
+
+        Atomic &variable(FrozenVariable const &v) const noexcept {
+            return *_indexedVariables[v._index];
+        }
+
+        // The variables in the order they were added, at stable addresses and on distinct cache lines.
+        VariableArena _variables;
+        // The variables and their IDs, indexed in the order they were added
+        std::vector<Atomic *> _indexedVariables;
+        std::vector<std::uint_fast32_t> _variableIDs;
+        // The variables indexed by their ID, as long as the IDs are small enough for the index to
+        // stay dense. The other ones are hashed.
+        std::vector<Atomic *> _denseVariables;
+        std::unordered_map<std::uint_fast32_t, Atomic *> _sparseVariables;
 
         PetriNet &_this;
     };
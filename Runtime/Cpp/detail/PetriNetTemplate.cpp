@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  PetriNetTemplate.cpp
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+
+#include "../PetriNetTemplate.h"
+#include "PetriNetImpl.h"
+
+namespace Petri {
+
+    PetriNetTemplate::PetriNetTemplate(std::unique_ptr<PetriNet> prototype) {
+        if(!prototype) {
+            throw std::runtime_error("Cannot create a template without a prototype!");
+        }
+        if(prototype->running()) {
+            throw std::runtime_error("Cannot create a template from a running petri net!");
+        }
+
+        // A template of an instance is the template of its prototype.
+        if(prototype->_internals->_prototype) {
+            _prototype = prototype->_internals->_prototype;
+            return;
+        }
+
+        prototype->_internals->freeze();
+        _prototype = std::move(prototype);
+    }
+
+    PetriNetTemplate::~PetriNetTemplate() = default;
+
+    std::unique_ptr<PetriNet> PetriNetTemplate::instantiate() const {
+        return this->instantiate(_prototype->executor());
+    }
+
+    std::unique_ptr<PetriNet> PetriNetTemplate::instantiate(WorkerOptions const &workerOptions) const {
+        return this->instantiate(PetriNet::Internals::ownExecutor(_prototype->name(), workerOptions));
+    }
+
+    std::unique_ptr<PetriNet> PetriNetTemplate::instantiate(std::shared_ptr<Executor> executor) const {
+        auto const &prototype = *_prototype->_internals;
+
+        auto net = std::make_unique<PetriNet>(prototype._name, std::move(executor));
+        auto &internals = *net->_internals;
+        internals._prototype = _prototype;
+        internals._topology = &prototype._frozen;
+        internals._evaluationMode = prototype._evaluationMode;
+        internals._executionMode = prototype._executionMode;
+
+        // The topology designates the variables by the order in which they were added.
+        for(std::size_t i = 0; i < prototype._variableIDs.size(); ++i) {
+            net->addVariable(prototype._variableIDs[i]);
+            internals._indexedVariables.back()->value() = prototype._indexedVariables[i]->value();
+        }
+
+        return net;
+    }
+
+    std::string const &PetriNetTemplate::name() const {
+        return _prototype->name();
+    }
+}
@@ -29,6 +29,7 @@
 
 #include "../Common.h"
 #include "../PetriUtils.h"
+#include "VirtualDelay.h"
 #include <iostream>
 #include <random>
 #include <thread>
@@ -53,7 +54,10 @@ namespace Petri {
             std::default_random_engine _engine{_rd()};
         }
         actionResult_t pause(std::chrono::nanoseconds const &delay) {
-            std::this_thread::sleep_for(delay);
+            // A simulated net only advances its virtual clock.
+            if(!VirtualDelay::add(delay)) {
+                std::this_thread::sleep_for(delay);
+            }
             return {};
         }
 
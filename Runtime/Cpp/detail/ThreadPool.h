@@ -32,14 +32,26 @@
 
 #include "../Callable.h"
 #include "../Common.h"
+#include "WorkStealingQueue.h"
+#include <algorithm>
 #include <atomic>
+#include <climits>
+#include <cstddef>
+#include <functional>
 #include <future>
+#include <iostream>
+#include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <system_error>
 #include <thread>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define PETRI_PTHREAD_WORKERS 1
+#endif
+
 namespace Petri {
 
     template <typename CallableType>
@@ -47,6 +59,245 @@ namespace Petri {
         return Callable<CallableType, std::result_of_t<CallableType()>>(c);
     }
 
+    /**
+     * A thread whose stack size can be chosen, where the platform allows it.
+     */
+    class WorkerThread {
+    public:
+        WorkerThread(std::size_t stackSize, std::function<void()> function) {
+#if PETRI_PTHREAD_WORKERS
+            pthread_attr_t attributes;
+            pthread_attr_init(&attributes);
+            if(stackSize > 0) {
+                pthread_attr_setstacksize(&attributes, std::max<std::size_t>(stackSize, PTHREAD_STACK_MIN));
+            }
+
+            auto f = std::make_unique<std::function<void()>>(std::move(function));
+            int error = pthread_create(&_thread, &attributes, &WorkerThread::start, f.get());
+            pthread_attr_destroy(&attributes);
+            if(error != 0) {
+                throw std::system_error(error, std::system_category(), "Could not create a worker thread");
+            }
+            f.release();
+            _joinable = true;
+#else
+            (void)stackSize;
+            _thread = std::thread(std::move(function));
+#endif
+        }
+
+        WorkerThread(WorkerThread &&other) noexcept
+                : _thread(std::move(other._thread)) {
+#if PETRI_PTHREAD_WORKERS
+            _joinable = other._joinable;
+            other._joinable = false;
+#endif
+        }
+
+        WorkerThread(WorkerThread const &) = delete;
+        WorkerThread &operator=(WorkerThread const &) = delete;
+
+        ~WorkerThread() {
+            if(this->joinable()) {
+                std::terminate();
+            }
+        }
+
+        bool joinable() const {
+#if PETRI_PTHREAD_WORKERS
+            return _joinable;
+#else
+            return _thread.joinable();
+#endif
+        }
+
+        bool isCurrentThread() const {
+#if PETRI_PTHREAD_WORKERS
+            return _joinable && pthread_equal(_thread, pthread_self());
+#else
+            return _thread.get_id() == std::this_thread::get_id();
+#endif
+        }
+
+        void join() {
+#if PETRI_PTHREAD_WORKERS
+            pthread_join(_thread, nullptr);
+            _joinable = false;
+#else
+            _thread.join();
+#endif
+        }
+
+    private:
+#if PETRI_PTHREAD_WORKERS
+        static void *start(void *arg) {
+            std::unique_ptr<std::function<void()>> f(static_cast<std::function<void()> *>(arg));
+            (*f)();
+            return nullptr;
+        }
+
+        pthread_t _thread;
+        bool _joinable = false;
+#else
+        std::thread _thread;
+#endif
+    };
+
+    /**
+     * The storage of a queued task. The callables small enough are stored inline, and the slots
+     * are recycled through per-thread caches, so that queueing a task does not allocate once the
+     * caches are warm.
+     */
+    class TaskSlot {
+    public:
+        // Keeps a slot on a single cache line.
+        static constexpr std::size_t BufferSize = 48;
+
+        /**
+         * Gets a slot from the cache of the calling thread, and stores the callable in it.
+         * @param function The callable to store, invoked with no argument
+         * @return The slot, to be either run or discarded
+         */
+        template <typename Function>
+        static TaskSlot *make(Function &&function) {
+            using Stored = std::decay_t<Function>;
+            auto slot = acquire();
+            slot->store<Stored>(std::forward<Function>(function),
+                                std::integral_constant<bool, fitsInline<Stored>()>{});
+            return slot;
+        }
+
+        /**
+         * Invokes the stored callable, and gives the slot back to the cache of the calling thread.
+         */
+        void run() {
+            _invoke(*this, true);
+            release(this);
+        }
+
+        /**
+         * Destroys the stored callable without invoking it, and gives the slot back to the cache
+         * of the calling thread.
+         */
+        void discard() {
+            _invoke(*this, false);
+            release(this);
+        }
+
+        // Used by InjectionQueue
+        std::atomic<TaskSlot *> _next = {nullptr};
+
+    private:
+        using Buffer = std::aligned_storage_t<BufferSize, alignof(std::max_align_t)>;
+
+        // Count of slots moved at once between a thread cache and the shared pool
+        static constexpr std::size_t Batch = 32;
+        // The slots given back beyond this count are freed
+        static constexpr std::size_t MaxPooled = 64 * Batch;
+
+        struct SharedPool {
+            ~SharedPool() {
+                for(auto slot : _slots) {
+                    delete slot;
+                }
+            }
+
+            std::mutex _mutex;
+            std::vector<TaskSlot *> _slots;
+        };
+
+        struct Cache {
+            Cache() {
+                _slots.reserve(2 * Batch);
+            }
+            ~Cache() {
+                for(auto slot : _slots) {
+                    delete slot;
+                }
+            }
+
+            std::vector<TaskSlot *> _slots;
+        };
+
+        template <typename Stored>
+        static constexpr bool fitsInline() {
+            return sizeof(Stored) <= sizeof(Buffer) && alignof(Buffer) % alignof(Stored) == 0 &&
+                   std::is_nothrow_move_constructible<Stored>::value;
+        }
+
+        template <typename Stored, typename Function>
+        void store(Function &&function, std::true_type) {
+            new(&_buffer) Stored(std::forward<Function>(function));
+            _invoke = [](TaskSlot &slot, bool run) {
+                auto &stored = *reinterpret_cast<Stored *>(&slot._buffer);
+                if(run) {
+                    stored();
+                }
+                stored.~Stored();
+            };
+        }
+
+        template <typename Stored, typename Function>
+        void store(Function &&function, std::false_type) {
+            new(&_buffer) Stored *(new Stored(std::forward<Function>(function)));
+            _invoke = [](TaskSlot &slot, bool run) {
+                std::unique_ptr<Stored> stored(*reinterpret_cast<Stored **>(&slot._buffer));
+                if(run) {
+                    (*stored)();
+                }
+            };
+        }
+
+        static SharedPool &sharedPool() {
+            static SharedPool pool;
+            return pool;
+        }
+
+        static std::vector<TaskSlot *> &cache() {
+            static thread_local Cache cache;
+            return cache._slots;
+        }
+
+        static TaskSlot *acquire() {
+            auto &slots = cache();
+            if(slots.empty()) {
+                auto &pool = sharedPool();
+                std::lock_guard<std::mutex> lk(pool._mutex);
+                auto count = std::min(std::size_t{Batch}, pool._slots.size());
+                slots.insert(slots.end(), pool._slots.end() - count, pool._slots.end());
+                pool._slots.resize(pool._slots.size() - count);
+            }
+            if(slots.empty()) {
+                return new TaskSlot;
+            }
+
+            auto slot = slots.back();
+            slots.pop_back();
+            return slot;
+        }
+
+        static void release(TaskSlot *slot) {
+            auto &slots = cache();
+            slots.push_back(slot);
+            if(slots.size() == 2 * Batch) {
+                // The threads consuming more tasks than they produce give their slots back.
+                auto &pool = sharedPool();
+                std::lock_guard<std::mutex> lk(pool._mutex);
+                for(std::size_t i = 0; i < Batch; ++i) {
+                    if(pool._slots.size() < MaxPooled) {
+                        pool._slots.push_back(slots.back());
+                    } else {
+                        delete slots.back();
+                    }
+                    slots.pop_back();
+                }
+            }
+        }
+
+        void (*_invoke)(TaskSlot &, bool run) = nullptr;
+        Buffer _buffer;
+    };
+
     template <typename _ReturnType>
     class ThreadPool {
         using ReturnType = _ReturnType;
@@ -149,24 +400,63 @@ namespace Petri {
                 return _proxy ? static_cast<bool>(_proxy->_valOK) : false;
             }
 
+            /**
+             * Checks whether the task has been accepted by the thread pool, i.e. not rejected
+             * because of its overflow policy.
+             * @return true if the task is associated to the proxy
+             */
+            bool accepted() const {
+                return static_cast<bool>(_proxy);
+            }
+
         private:
             std::shared_ptr<TaskManager> _proxy;
         };
 
+        // The workers are never destroyed before the pool, so that thieves can safely go through
+        // them. The worker of a reaped thread is reused by the next spawned thread.
+        struct Worker {
+            Worker(ThreadPool &pool)
+                    : _pool(pool) {}
+
+            ThreadPool &_pool;
+            ChaseLevDeque<TaskSlot *> _deque;
+            // Immutable once the worker has been published
+            Worker *_next = nullptr;
+
+            // Protected by _workersMutex
+            std::unique_ptr<WorkerThread> _thread;
+        };
+
     public:
         /**
          * Creates the thread pool.
-         * @param capacity Max number of concurrent task at a given time
+         * @param capacity Initial number of worker threads
          * @param name     This string is used for debug purposes: it gives a name to each worker
          * threads,
          *                 allowing for fast thread discimination when run through a debugger
          */
         ThreadPool(std::size_t capacity, std::string const &name = "")
-                : _workerThreads(capacity)
+                : ThreadPool(optionsWithCapacity(capacity), name) {}
+
+        /**
+         * Creates the thread pool. Each worker thread has its own deque of tasks, where the tasks
+         * added by the worker go and from which the idle workers steal. The tasks added by other
+         * threads go through a lock-free injection queue.
+         * @param options  Controls the count, stack size and lifetime of the worker threads
+         * @param name     This string is used for debug purposes: it gives a name to each worker
+         * threads,
+         *                 allowing for fast thread discimination when run through a debugger
+         */
+        ThreadPool(WorkerOptions const &options, std::string const &name = "")
+                : _options(options)
                 , _name(name) {
-            int count = 0;
-            for(auto &t : _workerThreads) {
-                t = std::thread(&ThreadPool::work, this, _name + "_worker " + std::to_string(count++));
+            _options.maxWorkers = std::max<std::size_t>(_options.maxWorkers, 1);
+            _options.minWorkers = std::min(_options.minWorkers, _options.maxWorkers);
+
+            std::lock_guard<std::mutex> lk(_workersMutex);
+            while(_activeWorkers < _options.minWorkers) {
+                this->spawnWorker();
             }
         }
 
@@ -180,6 +470,20 @@ namespace Petri {
                 std::cerr << "Thread pool is still alive!" << std::endl;
                 throw std::runtime_error("The thread pool is strill alive!");
             }
+
+            // The tasks which have not been executed are dropped.
+            while(auto task = this->injectedTask()) {
+                task->discard();
+            }
+            auto worker = _workers.load();
+            while(worker != nullptr) {
+                while(auto task = worker->_deque.steal()) {
+                    task->discard();
+                }
+                auto next = worker->_next;
+                delete worker;
+                worker = next;
+            }
         }
 
         /**
@@ -188,18 +492,28 @@ namespace Petri {
          * @return The current worker threads count
          */
         std::size_t threadCount() const {
-            return _workerThreads.size();
+            return _activeWorkers;
+        }
+
+        /**
+         * Returns the options controlling the worker threads.
+         */
+        WorkerOptions const &options() const {
+            return _options;
         }
 
         /**
-         * Increments the worker threads count, i.e. allows one more concurrent task to run.
+         * Increments the worker threads count, i.e. allows one more concurrent task to run, unless
+         * the maximum count of workers is already reached.
          */
         void addThread() {
             if(!_alive)
                 throw std::runtime_error("The thread pool is not alive anymore!");
-            _workerThreads.emplace_back(&ThreadPool::work,
-                                        this,
-                                        _name + "_worker " + std::to_string(_workerThreads.size()));
+
+            std::lock_guard<std::mutex> lk(_workersMutex);
+            if(_activeWorkers < _options.maxWorkers) {
+                this->spawnWorker();
+            }
         }
 
         /**
@@ -207,12 +521,12 @@ namespace Petri {
          */
         void join() {
             if(_alive) {
-                // Dirty hack…
-                while(_pendingTasks > 0) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                {
+                    std::unique_lock<std::mutex> lk(_sleepMutex);
+                    _tasksDone.wait(lk, [this]() { return _pendingTasks == 0 || !_alive; });
                 }
 
-                this->cancel();
+                this->stop();
             }
         }
 
@@ -221,15 +535,46 @@ namespace Petri {
          * The thread pool will be ineffective after that.
          */
         void stop() {
-            _alive = false;
-            _taskAvailable.notify_all();
+            {
+                std::lock_guard<std::mutex> lk(_sleepMutex);
+                _alive = false;
+                _wakeUp.notify_all();
+            }
 
-            for(auto &t : _workerThreads) {
-                if(t.joinable() && t.get_id() != std::this_thread::get_id())
-                    t.join();
+            std::list<WorkerThread> threads;
+            {
+                std::lock_guard<std::mutex> lk(_workersMutex);
+                for(auto worker = _workers.load(); worker != nullptr; worker = worker->_next) {
+                    if(worker->_thread) {
+                        threads.push_back(std::move(*worker->_thread));
+                        worker->_thread.reset();
+                    }
+                }
+                threads.splice(threads.end(), _exitedWorkers);
+            }
+
+            for(auto &t : threads) {
+                if(t.joinable()) {
+                    if(t.isCurrentThread()) {
+                        // The thread stopping the pool is one of its workers, which exits on its own.
+                        std::lock_guard<std::mutex> lk(_workersMutex);
+                        _exitedWorkers.push_back(std::move(t));
+                    } else {
+                        t.join();
+                    }
+                }
             }
 
+            std::lock_guard<std::mutex> lk(_sleepMutex);
             _pendingTasks = 0;
+            _tasksDone.notify_all();
+        }
+
+        /**
+         * Returns whether the execution of the thread pool is paused.
+         */
+        bool paused() const {
+            return _pause;
         }
 
         /**
@@ -253,62 +598,329 @@ namespace Petri {
             if(_alive) {
                 bool d = true;
                 if(_pause.compare_exchange_strong(d, false)) {
-                    _taskAvailable.notify_all();
+                    {
+                        std::lock_guard<std::mutex> lk(_sleepMutex);
+                        _wakeUp.notify_all();
+                    }
+                    this->addMissingWorkers();
                 }
             }
         }
 
+        /**
+         * Adds a task to the thread pool, handled according to the overflow policy of the pool if
+         * all of the workers are busy and none can be added.
+         * @param task The task to be addes.
+         * @return A proxy object allowing the user to wait for the task completion, query the task
+         * completion status and get the task return value. It is not associated to any task if the
+         * task has been rejected.
+         */
+        TaskResult addTask(CallableBase<ReturnType> const &task) {
+            return this->addTask(task, _options.overflowPolicy);
+        }
+
         /**
          * Adds a task to the thread pool.
          * @param task The task to be addes.
+         * @param overflowPolicy What to do with the task if all of the workers are busy and none can
+         * be added.
          * @return A proxy object allowing the user to wait for the task completion, query the task
-         * completion status and get the task return value
+         * completion status and get the task return value. It is not associated to any task if the
+         * task has been rejected.
          */
-        TaskResult
-        addTask(CallableBase<ReturnType> const &task) { //, std::chrono::nanoseconds timeout) {
+        TaskResult addTask(CallableBase<ReturnType> const &task, WorkerOptions::OverflowPolicy overflowPolicy) {
             TaskResult result;
+
+            bool overflow = this->overflows(overflowPolicy);
+            if(overflow && overflowPolicy == WorkerOptions::OverflowPolicy::Reject) {
+                return result;
+            }
+
             // task must be kept alive until execution finishes
             result._proxy = std::make_shared<TaskManager>(task.copy_ptr());
 
-            std::lock_guard<std::mutex> lk(_availabilityMutex);
-            ++_pendingTasks;
-            _taskQueue.push(result._proxy);
-            _taskAvailable.notify_one();
+            if(!overflow || !runInline([&result]() { result._proxy->execute(); })) {
+                this->enqueue(TaskSlot::make([proxy = result._proxy]() { proxy->execute(); }));
+            }
 
             return result;
         }
 
+        /**
+         * Adds a task to the thread pool, handled according to the overflow policy of the pool if
+         * all of the workers are busy and none can be added. Unlike addTask(), the completion of
+         * the task cannot be waited for, and the small callables are queued without allocation.
+         * @param function The callable to be invoked with no argument. Its return value is ignored.
+         * @return false if the task has been rejected
+         */
+        template <typename Function>
+        bool post(Function &&function) {
+            return this->post(std::forward<Function>(function), _options.overflowPolicy);
+        }
+
+        /**
+         * Adds a task to the thread pool. Unlike addTask(), the completion of the task cannot be
+         * waited for, and the small callables are queued without allocation.
+         * @param function The callable to be invoked with no argument. Its return value is ignored.
+         * @param overflowPolicy What to do with the task if all of the workers are busy and none can
+         * be added.
+         * @return false if the task has been rejected
+         */
+        template <typename Function>
+        bool post(Function &&function, WorkerOptions::OverflowPolicy overflowPolicy) {
+            bool overflow = this->overflows(overflowPolicy);
+            if(overflow && overflowPolicy == WorkerOptions::OverflowPolicy::Reject) {
+                return false;
+            }
+
+            if(!overflow || !runInline(function)) {
+                this->enqueue(TaskSlot::make(std::forward<Function>(function)));
+            }
+
+            return true;
+        }
+
+        /**
+         * Returns whether a task added with the overflow policy would find all of the workers busy,
+         * with none that could be added. The tasks added with OverflowPolicy::Queue never overflow.
+         * @param overflowPolicy The overflow policy of the task
+         */
+        bool overflows(WorkerOptions::OverflowPolicy overflowPolicy) const {
+            return overflowPolicy != WorkerOptions::OverflowPolicy::Queue && _alive && !_pause &&
+                   _queuedTasks >= _idleWorkers && _activeWorkers >= _options.maxWorkers;
+        }
+
+        /**
+         * Runs an overflowing task on the calling thread, unless the thread is already running one.
+         * An inline task adding another task would otherwise recurse without bound.
+         * @param function The callable to be invoked with no argument
+         * @return Whether the task has been run
+         */
+        template <typename Function>
+        static bool runInline(Function &&function) {
+            if(runningInline()) {
+                return false;
+            }
+
+            runningInline() = true;
+            function();
+            runningInline() = false;
+
+            return true;
+        }
+
     private:
-        void work(std::string const &name) {
+        static WorkerOptions optionsWithCapacity(std::size_t capacity) {
+            WorkerOptions options;
+            options.minWorkers = capacity;
+            return options;
+        }
+
+        static bool &runningInline() {
+            static thread_local bool inlineTask = false;
+            return inlineTask;
+        }
+
+        void enqueue(TaskSlot *task) {
+            ++_pendingTasks;
+            ++_queuedTasks;
+
+            auto worker = currentWorker();
+            if(worker != nullptr && &worker->_pool == this) {
+                worker->_deque.push(task);
+            } else {
+                _injection.push(task);
+            }
+
+            this->signalTask();
+        }
+
+        static Worker *&currentWorker() {
+            static thread_local Worker *worker = nullptr;
+            return worker;
+        }
+
+        // Makes sure a worker will take the task which has just been queued.
+        void signalTask() {
+            // Every queued task must be taken by its own worker, as tasks may block for a long time.
+            if(_queuedTasks > _idleWorkers && _activeWorkers < _options.maxWorkers) {
+                this->addMissingWorkers();
+            }
+            // A single worker is woken up at a time, and wakes up the next one if it finds more tasks
+            // than it can take.
+            if(_sleepingWorkers > 0 && !_pause && !_waking.exchange(true)) {
+                std::lock_guard<std::mutex> lk(_sleepMutex);
+                if(_sleepingWorkers > 0) {
+                    _wakeUp.notify_one();
+                } else {
+                    _waking = false;
+                }
+            }
+        }
+
+        void addMissingWorkers() {
+            std::lock_guard<std::mutex> lk(_workersMutex);
+            while(_alive && !_pause && _queuedTasks > _idleWorkers && _activeWorkers < _options.maxWorkers) {
+                this->spawnWorker();
+            }
+        }
+
+        // Must be called with _workersMutex locked.
+        void spawnWorker() {
+            // The threads which exited on their own are joined along the way.
+            for(auto &t : _exitedWorkers) {
+                if(t.joinable() && !t.isCurrentThread()) {
+                    t.join();
+                }
+            }
+            _exitedWorkers.remove_if([](WorkerThread const &t) { return !t.joinable(); });
+
+            Worker *worker = _workers.load();
+            while(worker != nullptr && worker->_thread) {
+                worker = worker->_next;
+            }
+            if(worker == nullptr) {
+                worker = new Worker(*this);
+                worker->_next = _workers.load();
+                _workers.store(worker);
+            }
+
+            ++_activeWorkers;
+            ++_idleWorkers;
+
+            auto name = _name + "_worker " + std::to_string(_workersCount++);
+            worker->_thread =
+            std::make_unique<WorkerThread>(_options.stackSize, [this, worker, name]() { this->work(*worker, name); });
+        }
+
+        TaskSlot *injectedTask() {
+            TaskSlot *task = nullptr;
+            if(_injection.tryConsume()) {
+                task = _injection.pop();
+                _injection.endConsume();
+            }
+
+            return task;
+        }
+
+        TaskSlot *findTask(Worker &self) {
+            if(auto task = self._deque.pop()) {
+                return task;
+            }
+            if(auto task = this->injectedTask()) {
+                return task;
+            }
+
+            // Steals from the other workers, starting after ourselves so that the victims vary.
+            for(auto worker = self._next; worker != nullptr; worker = worker->_next) {
+                if(auto task = worker->_deque.steal()) {
+                    return task;
+                }
+            }
+            for(auto worker = _workers.load(); worker != &self && worker != nullptr; worker = worker->_next) {
+                if(auto task = worker->_deque.steal()) {
+                    return task;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void work(Worker &self, std::string const &name) {
             setThreadName(name);
+            currentWorker() = &self;
 
+            // The worker has been counted as idle when spawned.
             while(_alive) {
-                std::unique_lock<std::mutex> lk(_availabilityMutex);
-                _taskAvailable.wait(lk,
-                                    [this]() { return (!_taskQueue.empty() && !_pause) || !_alive; });
+                auto task = _pause ? nullptr : this->findTask(self);
+                if(task == nullptr) {
+                    if(!this->waitForTask(self)) {
+                        return;
+                    }
+                    continue;
+                }
+
+                --_idleWorkers;
+                if(--_queuedTasks > 0) {
+                    this->signalTask();
+                }
 
-                if(!_alive)
-                    return;
+                task->run();
 
-                auto taskManager = std::move(_taskQueue.front());
-                _taskQueue.pop();
+                if(--_pendingTasks == 0) {
+                    std::lock_guard<std::mutex> lk(_sleepMutex);
+                    _tasksDone.notify_all();
+                }
+                ++_idleWorkers;
+            }
+        }
 
-                lk.unlock();
+        // Returns false if the worker must exit.
+        bool waitForTask(Worker &self) {
+            {
+                std::unique_lock<std::mutex> lk(_sleepMutex);
+                ++_sleepingWorkers;
+                bool woken = _wakeUp.wait_for(lk, _options.idleTimeout, [this]() {
+                    // Any task queued from now on will either be found by this worker or wake up
+                    // another one.
+                    _waking = false;
+                    return !_alive || (!_pause && _queuedTasks > 0);
+                });
+                --_sleepingWorkers;
+
+                if(!_alive) {
+                    return false;
+                }
+                if(woken) {
+                    return true;
+                }
+            }
 
-                taskManager->execute();
+            {
+                std::lock_guard<std::mutex> lk(_workersMutex);
+                if(!_alive || _activeWorkers <= _options.minWorkers || _queuedTasks > 0 || !self._thread) {
+                    return _alive;
+                }
+
+                --_activeWorkers;
+                --_idleWorkers;
+                _exitedWorkers.push_back(std::move(*self._thread));
+                self._thread.reset();
+            }
 
-                --_pendingTasks;
+            // A task may have been queued while we were still counted as idle.
+            if(_queuedTasks > _idleWorkers) {
+                this->addMissingWorkers();
             }
+
+            return false;
         }
 
-        std::queue<std::shared_ptr<TaskManager>> _taskQueue;
-        std::condition_variable _taskAvailable;
-        std::mutex _availabilityMutex;
+        WorkerOptions _options;
+
+        InjectionQueue<TaskSlot> _injection;
+        std::atomic<Worker *> _workers = {nullptr};
 
         std::atomic_bool _pause = {false};
         std::atomic_bool _alive = {true};
         std::atomic_uint _pendingTasks = {0};
-        std::vector<std::thread> _workerThreads;
+        // The tasks in the deques and in the injection queue
+        std::atomic<std::size_t> _queuedTasks = {0};
+        std::atomic<std::size_t> _idleWorkers = {0};
+        std::atomic<std::size_t> _activeWorkers = {0};
+
+        std::atomic<std::size_t> _sleepingWorkers = {0};
+        // Set while a sleeping worker has been notified and has not woken up yet
+        std::atomic_bool _waking = {false};
+        std::mutex _sleepMutex;
+        std::condition_variable _wakeUp;
+        std::condition_variable _tasksDone;
+
+        // Protected by _workersMutex
+        std::mutex _workersMutex;
+        std::list<WorkerThread> _exitedWorkers;
+        std::size_t _workersCount = 0;
+
         std::string const _name;
     };
 }
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  TimerWheel.cpp
+//  IA Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#include "TimerWheel.h"
+#include "../Common.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace Petri {
+
+    constexpr std::int32_t TimerWheel::None;
+
+    namespace {
+        std::uint64_t rotateRight(std::uint64_t value, unsigned shift) {
+            shift &= 63;
+            return shift == 0 ? value : (value >> shift) | (value << (64 - shift));
+        }
+
+        unsigned countTrailingZeros(std::uint64_t value) {
+            assert(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+            unsigned count = 0;
+            while((value & 1) == 0) {
+                value >>= 1;
+                ++count;
+            }
+            return count;
+#endif
+        }
+    }
+
+    TimerWheel::TimerWheel(std::chrono::nanoseconds resolution, std::string const &name)
+            : _resolution(std::max(resolution, std::chrono::nanoseconds(1)))
+            , _name(name) {
+        for(auto &level : _slots) {
+            level.fill(None);
+        }
+        _occupied.fill(0);
+        _current = this->currentTick();
+        _wakeUp = std::numeric_limits<std::uint64_t>::max();
+
+        _thread = std::thread(&TimerWheel::run, this);
+    }
+
+    TimerWheel::~TimerWheel() {
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            _alive = false;
+            _condition.notify_all();
+        }
+        if(_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    TimerWheel &TimerWheel::shared() {
+        static TimerWheel wheel(std::chrono::microseconds(100), "Petri timers");
+        return wheel;
+    }
+
+    TimerWheel::TimerID TimerWheel::schedule(ClockType::time_point date, Callback callback) {
+        std::lock_guard<std::mutex> lk(_mutex);
+
+        std::int32_t index = _free;
+        if(index == None) {
+            index = static_cast<std::int32_t>(_nodes.size());
+            _nodes.emplace_back();
+        } else {
+            _free = _nodes[index].next;
+        }
+
+        if(_count == 0) {
+            // Nothing has been processed while the wheel was empty, so that we can skip the elapsed ticks.
+            _current = std::max(_current, this->currentTick());
+        }
+
+        auto &node = _nodes[index];
+        node.tick = this->tickOf(date);
+        node.callback = std::move(callback);
+        this->link(index);
+        ++_count;
+
+        if(node.tick < _wakeUp) {
+            _condition.notify_all();
+        }
+
+        return (static_cast<TimerID>(index + 1) << 32) | node.generation;
+    }
+
+    bool TimerWheel::cancel(TimerID id) {
+        if(id == 0) {
+            return false;
+        }
+
+        auto index = static_cast<std::int32_t>((id >> 32) - 1);
+        auto generation = static_cast<std::uint32_t>(id);
+
+        Callback callback;
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            if(index >= static_cast<std::int32_t>(_nodes.size()) || _nodes[index].generation != generation ||
+               _nodes[index].level == None) {
+                return false;
+            }
+
+            this->unlink(index);
+            // The callback is destroyed outside of the lock, as it may own resources we know nothing about.
+            callback = std::move(_nodes[index].callback);
+            this->release(index);
+        }
+
+        return true;
+    }
+
+    void TimerWheel::waitForCallbacks() {
+        if(std::this_thread::get_id() == _thread.get_id()) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lk(_mutex);
+        auto batch = _batch;
+        _batchCondition.wait(lk, [this, batch]() { return !_firing || _batch != batch; });
+    }
+
+    std::size_t TimerWheel::size() const {
+        std::lock_guard<std::mutex> lk(_mutex);
+        return _count;
+    }
+
+    std::uint64_t TimerWheel::tickOf(ClockType::time_point date) const {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(date.time_since_epoch()).count();
+        if(ns <= 0) {
+            return 0;
+        }
+
+        // Rounded up, so that a timer never fires before its date.
+        auto resolution = static_cast<std::uint64_t>(_resolution.count());
+        return (static_cast<std::uint64_t>(ns) + resolution - 1) / resolution;
+    }
+
+    std::uint64_t TimerWheel::currentTick() const {
+        // Rounded down, as the current tick is not over yet.
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now().time_since_epoch()).count();
+        return static_cast<std::uint64_t>(std::max<decltype(ns)>(ns, 0)) / static_cast<std::uint64_t>(_resolution.count());
+    }
+
+    ClockType::time_point TimerWheel::dateOf(std::uint64_t tick) const {
+        return ClockType::time_point(std::chrono::duration_cast<ClockType::duration>(_resolution * tick));
+    }
+
+    void TimerWheel::link(std::int32_t index) {
+        auto &node = _nodes[index];
+
+        // A timer already due is fired with the current tick.
+        auto tick = std::max(node.tick, _current);
+        auto delta = tick - _current;
+
+        int level = 0;
+        while(level < Levels - 1 && delta >= (std::uint64_t(1) << (SlotBits * (level + 1)))) {
+            ++level;
+        }
+
+        if(delta >= (std::uint64_t(1) << (SlotBits * Levels))) {
+            // Too far in the future: the timer is parked in the last slot of the top level, and
+            // will be cascaded again from there until it is in range.
+            tick = _current + (std::uint64_t(SlotsPerLevel - 1) << (SlotBits * level));
+        }
+
+        auto slot = static_cast<std::uint8_t>((tick >> (SlotBits * level)) & (SlotsPerLevel - 1));
+        auto &head = _slots[level][slot];
+
+        node.level = static_cast<std::int8_t>(level);
+        node.slot = slot;
+        node.previous = None;
+        node.next = head;
+        if(head != None) {
+            _nodes[head].previous = index;
+        }
+        head = index;
+        _occupied[level] |= std::uint64_t(1) << slot;
+    }
+
+    void TimerWheel::unlink(std::int32_t index) {
+        auto &node = _nodes[index];
+        auto &head = _slots[node.level][node.slot];
+
+        if(node.previous != None) {
+            _nodes[node.previous].next = node.next;
+        } else {
+            head = node.next;
+        }
+        if(node.next != None) {
+            _nodes[node.next].previous = node.previous;
+        }
+        if(head == None) {
+            _occupied[node.level] &= ~(std::uint64_t(1) << node.slot);
+        }
+
+        node.level = None;
+        node.previous = node.next = None;
+    }
+
+    void TimerWheel::release(std::int32_t index) {
+        auto &node = _nodes[index];
+        if(++node.generation == 0) {
+            node.generation = 1;
+        }
+        node.next = _free;
+        _free = index;
+        --_count;
+    }
+
+    std::uint64_t TimerWheel::nextTick() const {
+        auto next = std::numeric_limits<std::uint64_t>::max();
+
+        for(int level = 0; level < Levels; ++level) {
+            if(_occupied[level] == 0) {
+                continue;
+            }
+
+            unsigned shift = SlotBits * level;
+            auto position = _current >> shift;
+            auto rotated = rotateRight(_occupied[level], static_cast<unsigned>(position & (SlotsPerLevel - 1)));
+
+            if((_current & ((std::uint64_t(1) << shift) - 1)) != 0) {
+                // The current slot has already been cascaded, and now holds the timers of the next rotation.
+                rotated &= ~std::uint64_t(1);
+            }
+
+            auto distance = rotated == 0 ? unsigned(SlotsPerLevel) : countTrailingZeros(rotated);
+            auto tick = (position + distance) << shift;
+            next = std::min(next, tick);
+        }
+
+        return next;
+    }
+
+    void TimerWheel::advance(std::uint64_t now, std::vector<Callback> &expired) {
+        while(_current <= now) {
+            // Jumps over the ticks where nothing has to be done.
+            auto next = this->nextTick();
+            if(next > now) {
+                _current = now + 1;
+                break;
+            }
+            _current = std::max(_current, next);
+
+            // Cascades the upper slots starting at this tick, from the top level downwards.
+            for(int level = Levels - 1; level > 0; --level) {
+                unsigned shift = SlotBits * level;
+                if((_current & ((std::uint64_t(1) << shift) - 1)) != 0) {
+                    continue;
+                }
+
+                auto slot = (_current >> shift) & (SlotsPerLevel - 1);
+                auto index = _slots[level][slot];
+                _slots[level][slot] = None;
+                _occupied[level] &= ~(std::uint64_t(1) << slot);
+
+                while(index != None) {
+                    auto next = _nodes[index].next;
+                    this->link(index);
+                    index = next;
+                }
+            }
+
+            auto slot = _current & (SlotsPerLevel - 1);
+            auto index = _slots[0][slot];
+            _slots[0][slot] = None;
+            _occupied[0] &= ~(std::uint64_t(1) << slot);
+
+            while(index != None) {
+                auto &node = _nodes[index];
+                auto next = node.next;
+                node.level = None;
+                expired.push_back(std::move(node.callback));
+                this->release(index);
+                index = next;
+            }
+
+            ++_current;
+        }
+    }
+
+    void TimerWheel::run() {
+        setThreadName(_name);
+
+        std::vector<Callback> expired;
+        std::unique_lock<std::mutex> lk(_mutex);
+        while(_alive) {
+            this->advance(this->currentTick(), expired);
+
+            if(!expired.empty()) {
+                _wakeUp = 0;
+                _firing = true;
+                lk.unlock();
+                for(auto &callback : expired) {
+                    callback();
+                }
+                expired.clear();
+                lk.lock();
+                _firing = false;
+                ++_batch;
+                _batchCondition.notify_all();
+                continue;
+            }
+
+            if(_count == 0) {
+                _wakeUp = std::numeric_limits<std::uint64_t>::max();
+                _condition.wait(lk);
+            } else {
+                _wakeUp = this->nextTick();
+                _condition.wait_until(lk, this->dateOf(_wakeUp));
+            }
+        }
+    }
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  TimerWheel.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_TimerWheel_h
+#define Petri_TimerWheel_h
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Petri {
+
+    // We want a steady clock (no adjustments, only ticking forward in time), but it would be better
+    // if we got an high resolution clock.
+    using ClockType =
+    std::conditional<std::chrono::high_resolution_clock::is_steady, std::chrono::high_resolution_clock, std::chrono::steady_clock>::type;
+
+    /**
+     * A hierarchical timer wheel, firing its timers from a single thread. Scheduling and cancelling
+     * a timer are O(1), so that a single wheel can serve tens of thousands of pending timers.
+     * The timers are fired at the granularity of the wheel's resolution, never before their date.
+     */
+    class TimerWheel {
+    public:
+        // Identifies a scheduled timer. 0 never identifies a timer.
+        using TimerID = std::uint64_t;
+        using Callback = std::function<void()>;
+
+        /**
+         * Creates a timer wheel and starts its thread.
+         * @param resolution The duration of a tick of the wheel
+         * @param name The name of the wheel's thread
+         */
+        TimerWheel(std::chrono::nanoseconds resolution, std::string const &name);
+        ~TimerWheel();
+
+        TimerWheel(TimerWheel const &) = delete;
+        TimerWheel &operator=(TimerWheel const &) = delete;
+
+        /**
+         * Returns the timer wheel shared by all of the petri nets of the process.
+         */
+        static TimerWheel &shared();
+
+        /**
+         * Schedules a callback to be invoked on the wheel's thread once the date is reached. The
+         * callback must not block, as it delays the other timers.
+         * @param date The date at which the callback is invoked
+         * @param callback The callback to invoke
+         * @return The ID of the timer, to be given to cancel()
+         */
+        TimerID schedule(ClockType::time_point date, Callback callback);
+
+        /**
+         * Cancels a timer.
+         * @param id The ID of the timer, as returned by schedule()
+         * @return true if the timer was pending, false if it already fired or was cancelled
+         */
+        bool cancel(TimerID id);
+
+        /**
+         * Waits for the callbacks being invoked by the wheel's thread, if any. Once a timer has been
+         * cancelled, this guarantees that its callback is not running anymore.
+         */
+        void waitForCallbacks();
+
+        /**
+         * Returns the count of pending timers.
+         */
+        std::size_t size() const;
+
+    private:
+        enum { SlotBits = 6, SlotsPerLevel = 1 << SlotBits, Levels = 6 };
+        static constexpr std::int32_t None = -1;
+
+        struct Node {
+            std::uint64_t tick;
+            std::uint32_t generation = 1;
+            std::int32_t previous = None;
+            std::int32_t next = None;
+            std::int8_t level = None;
+            std::uint8_t slot = 0;
+            Callback callback;
+        };
+
+        std::uint64_t tickOf(ClockType::time_point date) const;
+        std::uint64_t currentTick() const;
+        ClockType::time_point dateOf(std::uint64_t tick) const;
+
+        void link(std::int32_t index);
+        void unlink(std::int32_t index);
+        void release(std::int32_t index);
+        std::uint64_t nextTick() const;
+        void advance(std::uint64_t now, std::vector<Callback> &expired);
+        void run();
+
+        std::chrono::nanoseconds const _resolution;
+        std::string const _name;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _alive = true;
+
+        // Set while the expired callbacks are invoked outside of the lock
+        bool _firing = false;
+        std::uint64_t _batch = 0;
+        std::condition_variable _batchCondition;
+
+        std::vector<Node> _nodes;
+        std::int32_t _free = None;
+        std::size_t _count = 0;
+
+        // The first tick not processed yet
+        std::uint64_t _current;
+        // The tick at which the thread will wake up next
+        std::uint64_t _wakeUp;
+
+        std::array<std::array<std::int32_t, SlotsPerLevel>, Levels> _slots;
+        std::array<std::uint64_t, Levels> _occupied;
+
+        std::thread _thread;
+    };
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  TokenContext.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+
+#ifndef Petri_TokenContext_h
+#define Petri_TokenContext_h
+
+#include "../TokenPayload.h"
+#include <stdexcept>
+#include <vector>
+
+namespace Petri {
+
+    class PetriNet;
+
+    /**
+     * The payloads of the action run by the calling thread: those of the tokens which activated
+     * it, and the one it sends to its successors.
+     */
+    class TokenContext {
+    public:
+        /**
+         * Makes the action run by the calling thread exchange its payloads through the object,
+         * until it is destroyed.
+         * @param net The net of the action
+         * @param sent The payload sent by the action, if any
+         */
+        TokenContext(PetriNet const &net, TokenPayload &sent) noexcept
+                : _net(net)
+                , _sent(sent)
+                , _previous(current()) {
+            current() = this;
+        }
+
+        ~TokenContext() {
+            current() = _previous;
+        }
+
+        TokenContext(TokenContext const &) = delete;
+        TokenContext &operator=(TokenContext const &) = delete;
+
+        /**
+         * Returns the context of the action of a net run by the calling thread.
+         * @param net The net of the action
+         */
+        static TokenContext &of(PetriNet const &net) {
+            if(current() == nullptr || &current()->_net != &net) {
+                throw std::runtime_error("The payloads of the tokens can only be accessed by an action of their net!");
+            }
+
+            return *current();
+        }
+
+        std::vector<TokenPayload> &received() noexcept {
+            return _received;
+        }
+
+        TokenPayload &sent() noexcept {
+            return _sent;
+        }
+
+    private:
+        static TokenContext *&current() noexcept {
+            static thread_local TokenContext *context = nullptr;
+            return context;
+        }
+
+        PetriNet const &_net;
+        std::vector<TokenPayload> _received;
+        TokenPayload &_sent;
+        TokenContext *const _previous;
+    };
+}
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "../Action.h"
 #include "../Transition.h"
+#include "EntityName.h"
 
 namespace Petri {
 
@@ -37,32 +38,38 @@ namespace Petri {
                 : _previous(&previous)
                 , _next(&next) {}
 
-        Internals(std::string const &name, Action &previous, Action &next, ParametrizedTransitionCallableBase const &cond)
+        template <typename Name>
+        Internals(Name const &name, Action &previous, Action &next, TransitionFunction cond)
                 : _name(name)
                 , _previous(&previous)
                 , _next(&next)
-                , _test(cond.copy_ptr()) {}
+                , _test(std::move(cond)) {}
 
-        std::string _name;
+        EntityName _name;
         Action *_previous;
         Action *_next;
-        std::unique_ptr<ParametrizedTransitionCallableBase> _test;
+        TransitionFunction _test;
 
         // Default delay between evaluation
         std::chrono::nanoseconds _delayBetweenEvaluation = 10ms;
     };
 
-    Transition::Transition(Action &previous, Action &next)
+    Transition::Transition(MonotonicArena *arena, Action &previous, Action &next)
             : Entity(0)
-            , _internals(std::make_unique<Internals>(previous, next)) {}
+            , _internals(makeArenaPtr<Internals>(arena, previous, next)) {}
 
-    Transition::Transition(uint64_t id,
+    Transition::Transition(MonotonicArena *arena,
+                           uint64_t id,
                            std::string const &name,
                            Action &previous,
                            Action &next,
-                           ParametrizedTransitionCallableBase const &cond)
+                           TransitionFunction cond)
             : Entity(id)
-            , _internals(std::make_unique<Internals>(name, previous, next, cond)) {}
+            , _internals(makeArenaPtr<Internals>(arena, name, previous, next, std::move(cond))) {}
+
+    Transition::Transition(MonotonicArena *arena, uint64_t id, InternedName name, Action &previous, Action &next, TransitionFunction cond)
+            : Entity(id)
+            , _internals(makeArenaPtr<Internals>(arena, name, previous, next, std::move(cond))) {}
 
     Transition::~Transition() = default;
     Transition::Transition(Transition &&) noexcept = default;
@@ -75,22 +82,23 @@ namespace Petri {
     }
 
     bool Transition::isFulfilled(PetriNet &pn, actionResult_t actionResult) const {
-        return (*_internals->_test)(pn, actionResult);
+        return _internals->_test(pn, actionResult);
     }
 
-    ParametrizedTransitionCallableBase const &Transition::condition() const noexcept {
-        return *_internals->_test;
+    TransitionFunction const &Transition::condition() const noexcept {
+        return _internals->_test;
     }
 
     void Transition::setCondition(TransitionCallableBase const &test) {
-        auto copy = test.copy_ptr();
-        auto shared_copy = std::shared_ptr<TransitionCallableBase>(copy.release());
-        this->setCondition(make_param_transition_callable(
-        std::move([shared_copy](PetriNet &, actionResult_t a) { return shared_copy->operator()(a); })));
+        this->setCondition([copy = test.copy_ptr()](PetriNet &, actionResult_t a) { return (*copy)(a); });
     }
 
     void Transition::setCondition(ParametrizedTransitionCallableBase const &test) {
-        _internals->_test = test.copy_ptr();
+        this->setCondition([copy = test.copy_ptr()](PetriNet &pn, actionResult_t a) { return (*copy)(pn, a); });
+    }
+
+    void Transition::setCondition(TransitionFunction test) {
+        _internals->_test = std::move(test);
     }
 
     Action &Transition::previous() noexcept {
@@ -102,7 +110,7 @@ namespace Petri {
     }
 
     std::string const &Transition::name() const noexcept {
-        return _internals->_name;
+        return _internals->_name.get();
     }
 
     void Transition::setName(std::string const &name) {
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  VariableArena.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_VariableArena_h
+#define Petri_VariableArena_h
+
+#include "../Atomic.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Petri {
+
+    // The granularity at which the caches of two cores conflict. Two objects written by different
+    // threads must not share a line of this size.
+    static constexpr std::size_t CacheLineSize = 64;
+
+    /**
+     * Stores the Atomic variables of a petri net at stable addresses, each of them starting on its
+     * own cache line and padded to a whole count of lines. Two variables modified by different
+     * threads then never share a cache line.
+     * The variables are allocated by chunks, as the standard allocators do not honor the alignment
+     * of over-aligned types in C++14.
+     */
+    class VariableArena {
+    public:
+        VariableArena() = default;
+
+        ~VariableArena() {
+            for(std::size_t i = 0; i < _size; ++i) {
+                slot(i).~Slot();
+            }
+        }
+
+        VariableArena(VariableArena const &) = delete;
+        VariableArena &operator=(VariableArena const &) = delete;
+
+        /**
+         * Creates a new variable, which lives as long as the arena.
+         * @return The new variable
+         */
+        Atomic &emplace() {
+            if(_size == _chunks.size() * SlotsPerChunk) {
+                _chunks.emplace_back(new unsigned char[SlotsPerChunk * sizeof(Slot) + CacheLineSize]);
+            }
+
+            auto slot = new(address(_size)) Slot;
+            ++_size;
+
+            return slot->_atomic;
+        }
+
+        /**
+         * Returns the count of variables of the arena.
+         */
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+    private:
+        struct alignas(CacheLineSize) Slot {
+            Atomic _atomic;
+        };
+        static_assert(sizeof(Slot) % CacheLineSize == 0, "A variable must fill whole cache lines!");
+
+        static constexpr std::size_t SlotsPerChunk = 32;
+
+        // The storage of the slot at the given index, aligned on a cache line within its chunk.
+        void *address(std::size_t index) const noexcept {
+            auto base = reinterpret_cast<std::uintptr_t>(_chunks[index / SlotsPerChunk].get());
+            base = (base + CacheLineSize - 1) & ~static_cast<std::uintptr_t>(CacheLineSize - 1);
+
+            return reinterpret_cast<void *>(base + (index % SlotsPerChunk) * sizeof(Slot));
+        }
+
+        Slot &slot(std::size_t index) const noexcept {
+            return *static_cast<Slot *>(address(index));
+        }
+
+        std::vector<std::unique_ptr<unsigned char[]>> _chunks;
+        std::size_t _size = 0;
+    };
+}
+
+#endif
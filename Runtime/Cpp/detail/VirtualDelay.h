@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  VirtualDelay.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_VirtualDelay_h
+#define Petri_VirtualDelay_h
+
+#include <chrono>
+
+namespace Petri {
+
+    /**
+     * Collects the pauses of the action run by the calling thread for a net in the Simulated
+     * execution mode. They advance the virtual clock of the net instead of blocking the thread.
+     */
+    class VirtualDelay {
+    public:
+        /**
+         * Makes the calling thread collect its pauses into a delay, until the object is destroyed.
+         * @param delay The delay to add the pauses to
+         */
+        VirtualDelay(std::chrono::nanoseconds &delay) noexcept
+                : _previous(current()) {
+            current() = &delay;
+        }
+
+        ~VirtualDelay() {
+            current() = _previous;
+        }
+
+        VirtualDelay(VirtualDelay const &) = delete;
+        VirtualDelay &operator=(VirtualDelay const &) = delete;
+
+        /**
+         * Adds a pause to the delay collected by the calling thread, if any.
+         * @param pause The duration of the pause
+         * @return false if the calling thread does not collect its pauses
+         */
+        static bool add(std::chrono::nanoseconds pause) noexcept {
+            if(current() == nullptr) {
+                return false;
+            }
+
+            *current() += pause;
+            return true;
+        }
+
+    private:
+        static std::chrono::nanoseconds *&current() noexcept {
+            static thread_local std::chrono::nanoseconds *delay = nullptr;
+            return delay;
+        }
+
+        std::chrono::nanoseconds *const _previous;
+    };
+}
+
+#endif
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2015 Rémi Saurel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//
+//  WorkStealingQueue.h
+//  Pétri
+//
+//  Created by Rémi on 17/10/2026.
+//
+
+#ifndef Petri_WorkStealingQueue_h
+#define Petri_WorkStealingQueue_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Petri {
+
+    /**
+     * A Chase-Lev work-stealing deque of pointers. Only its owner thread may push and pop at the
+     * bottom, while any thread may steal from the top.
+     */
+    template <typename T>
+    class ChaseLevDeque {
+        static_assert(std::is_pointer<T>::value, "The deque only holds pointers.");
+
+        struct Array {
+            Array(std::int64_t capacity)
+                    : _capacity(capacity)
+                    , _buffer(new std::atomic<T>[capacity]) {}
+
+            T get(std::int64_t index) const {
+                return _buffer[index & (_capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t index, T value) {
+                _buffer[index & (_capacity - 1)].store(value, std::memory_order_relaxed);
+            }
+
+            std::int64_t const _capacity;
+            std::unique_ptr<std::atomic<T>[]> _buffer;
+        };
+
+    public:
+        ChaseLevDeque(std::int64_t capacity = 64) {
+            _arrays.push_back(std::make_unique<Array>(capacity));
+            _array = _arrays.back().get();
+        }
+
+        ChaseLevDeque(ChaseLevDeque const &) = delete;
+        ChaseLevDeque &operator=(ChaseLevDeque const &) = delete;
+
+        /**
+         * Pushes a value at the bottom of the deque. Must only be called by the owner.
+         * @param value The value to push
+         */
+        void push(T value) {
+            auto bottom = _bottom.load(std::memory_order_relaxed);
+            auto top = _top.load(std::memory_order_acquire);
+            auto array = _array.load(std::memory_order_relaxed);
+
+            if(bottom - top > array->_capacity - 1) {
+                array = this->grow(array, bottom, top);
+            }
+
+            array->put(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Pops the last pushed value. Must only be called by the owner.
+         * @return The value, or nullptr if the deque is empty
+         */
+        T pop() {
+            auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            auto array = _array.load(std::memory_order_relaxed);
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = _top.load(std::memory_order_relaxed);
+
+            T value = nullptr;
+            if(top <= bottom) {
+                value = array->get(bottom);
+                if(top == bottom) {
+                    // Last value, which a thief may be stealing concurrently.
+                    if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        value = nullptr;
+                    }
+                    _bottom.store(bottom + 1, std::memory_order_relaxed);
+                }
+            } else {
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return value;
+        }
+
+        /**
+         * Steals the first pushed value. May be called by any thread.
+         * @return The value, or nullptr if the deque is empty or if another thread won the race
+         */
+        T steal() {
+            auto top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto bottom = _bottom.load(std::memory_order_acquire);
+
+            if(top < bottom) {
+                auto array = _array.load(std::memory_order_acquire);
+                T value = array->get(top);
+                if(_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return value;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * Returns whether the deque looks empty. The result is only a hint when called concurrently.
+         */
+        bool empty() const {
+            return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        Array *grow(Array *array, std::int64_t bottom, std::int64_t top) {
+            auto bigger = std::make_unique<Array>(array->_capacity * 2);
+            for(auto i = top; i < bottom; ++i) {
+                bigger->put(i, array->get(i));
+            }
+
+            // The previous arrays are kept alive, as thieves may still be reading them.
+            _arrays.push_back(std::move(bigger));
+            _array.store(_arrays.back().get(), std::memory_order_release);
+
+            return _arrays.back().get();
+        }
+
+        std::atomic<std::int64_t> _top = {0};
+        std::atomic<std::int64_t> _bottom = {0};
+        std::atomic<Array *> _array;
+        // Only modified by the owner
+        std::vector<std::unique_ptr<Array>> _arrays;
+    };
+
+    /**
+     * An intrusive multiple producers, single consumer queue. Pushing never blocks nor fails, and
+     * popping is lock-free. The Node type must have a std::atomic<Node *> _next member.
+     */
+    template <typename Node>
+    class InjectionQueue {
+    public:
+        InjectionQueue()
+                : _head(&_stub)
+                , _tail(&_stub) {}
+
+        InjectionQueue(InjectionQueue const &) = delete;
+        InjectionQueue &operator=(InjectionQueue const &) = delete;
+
+        /**
+         * Pushes a node at the end of the queue. May be called by any thread.
+         * @param node The node to push
+         */
+        void push(Node *node) {
+            node->_next.store(nullptr, std::memory_order_relaxed);
+            auto previous = _head.exchange(node, std::memory_order_acq_rel);
+            previous->_next.store(node, std::memory_order_release);
+        }
+
+        /**
+         * Pops the first node of the queue. Must not be called concurrently, see tryConsume().
+         * @return The node, or nullptr if the queue is empty or a push is not complete yet
+         */
+        Node *pop() {
+            auto tail = _tail;
+            auto next = tail->_next.load(std::memory_order_acquire);
+
+            if(tail == &_stub) {
+                if(next == nullptr) {
+                    return nullptr;
+                }
+                _tail = next;
+                tail = next;
+                next = next->_next.load(std::memory_order_acquire);
+            }
+
+            if(next != nullptr) {
+                _tail = next;
+                return tail;
+            }
+
+            if(tail != _head.load(std::memory_order_acquire)) {
+                // A producer is in the middle of a push
+                return nullptr;
+            }
+
+            this->push(&_stub);
+
+            next = tail->_next.load(std::memory_order_acquire);
+            if(next != nullptr) {
+                _tail = next;
+                return tail;
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * Acquires the right to pop from the queue, without blocking.
+         * @return true if the caller is now the only consumer of the queue, and must call
+         * endConsume() when done
+         */
+        bool tryConsume() {
+            return !_consuming.test_and_set(std::memory_order_acquire);
+        }
+
+        void endConsume() {
+            _consuming.clear(std::memory_order_release);
+        }
+
+    private:
+        std::atomic<Node *> _head;
+        Node *_tail;
+        Node _stub;
+        std::atomic_flag _consuming = ATOMIC_FLAG_INIT;
+    };
+}
+
+#endif